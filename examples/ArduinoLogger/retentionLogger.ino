@@ -0,0 +1,44 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * Example code for a logger keeping its last lines across resets
+ *
+ * The last characters written to a RetentionSink are kept in a RAM buffer
+ * that is not cleared by a reset (watchdog, reset button...)
+ * They can be displayed again at the next boot
+ */
+
+#include <Arduino.h>
+#include <ArduinoLogger.h>
+#include <AL_retention.h>
+
+AL_RETAINED uint8_t retainedBuffer[512]; // Not initialised at boot
+
+RetentionSink retention (retainedBuffer, sizeof(retainedBuffer));
+
+void setup ()
+{
+	Serial.begin (9600);
+
+	logger.add (Serial, LOG_LEVEL_VERBOSE);
+
+	if (retention.begin()) // Something was logged before the reset
+	{
+		warn << "Lines logged before the reset :" << endl;
+		retention.replay (Serial);
+	}
+
+	logger.add (retention, LOG_LEVEL_VERBOSE); // From now on, everything is also kept in the retained buffer
+
+	inf << "Setup done" << endl;
+} // setup
+
+void loop ()
+{
+	static uint32_t n = 0;
+
+	inf << "Loop " << n++ << endl;
+
+	delay (1000);
+}
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Farès Chati
+# This file id part of the ArduinoLogger library.
+# MIT License, see LICENSE
+#
+# Outputs the lines of a log file logged in a time window, using the index of an IndexedSink
+#
+# Usage: logindex.py LOG.TXT INDEX.BIN FROM [TO]
+# FROM and TO are Unix times or UTC dates ("2020-05-11 14:32[:00]"), TO defaults to the end of the log
+
+import bisect
+import calendar
+import struct
+import sys
+import time
+
+ENTRY = struct.Struct("<II")  # Time, offset
+
+
+def parse_time(text):
+	if text.isdigit():
+		return int(text)
+
+	for fmt in ("%Y-%m-%d %H:%M:%S", "%Y-%m-%d %H:%M", "%Y-%m-%dT%H:%M:%S", "%Y-%m-%dT%H:%M"):
+		try:
+			return calendar.timegm(time.strptime(text, fmt))
+		except ValueError:
+			pass
+
+	raise ValueError("invalid time: %s" % text)
+
+
+def read_index(path):
+	with open(path, "rb") as f:
+		data = f.read()
+
+	count = len(data) // ENTRY.size  # An incomplete last entry is ignored
+	entries = [ENTRY.unpack_from(data, i * ENTRY.size) for i in range(count)]
+
+	return [e[0] for e in entries], [e[1] for e in entries]
+
+
+def runs(times, offsets, size):
+	# The times only increase, unless the clock was set back: each increasing run is searched on its own
+	first = 0
+	for i in range(1, len(times) + 1):
+		if i == len(times) or times[i] < times[i - 1]:
+			# The lines before the first entry belong to the first run
+			begin = offsets[first] if first else 0
+			end = offsets[i] if i < len(times) else size
+			yield times[first:i], offsets[first:i], begin, end
+			first = i
+
+
+def window(times, offsets, start, end, begin, size):
+	# Part of the log of one run, which covers begin to size
+	first = bisect.bisect_right(times, start) - 1
+	if first >= 0:
+		begin = offsets[first]
+
+	if end is None:
+		return begin, size
+
+	last = bisect.bisect_right(times, end)
+	return begin, offsets[last] if last < len(offsets) else size
+
+
+def windows(times, offsets, start, end, size):
+	if not times:
+		return [(0, size)]
+
+	parts = []
+	for run_times, run_offsets, run_begin, run_end in runs(times, offsets, size):
+		begin, stop = window(run_times, run_offsets, start, end, run_begin, run_end)
+		if begin >= stop:
+			continue
+		if parts and parts[-1][1] >= begin:
+			parts[-1] = (parts[-1][0], max(parts[-1][1], stop))
+		else:
+			parts.append((begin, stop))
+
+	return parts
+
+
+def main():
+	if len(sys.argv) < 4:
+		sys.stderr.write("usage: %s LOG.TXT INDEX.BIN FROM [TO]\n" % sys.argv[0])
+		return 1
+
+	start = parse_time(sys.argv[3])
+	end = parse_time(sys.argv[4]) if len(sys.argv) > 4 else None
+	times, offsets = read_index(sys.argv[2])
+
+	with open(sys.argv[1], "rb") as log:
+		log.seek(0, 2)
+		out = sys.stdout.buffer
+
+		for begin, stop in windows(times, offsets, start, end, log.tell()):
+			log.seek(begin)
+			while begin < stop:
+				block = log.read(min(1 << 16, stop - begin))
+				if not block:
+					break
+				out.write(block)
+				begin += len(block)
+
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
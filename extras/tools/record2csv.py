@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Farès Chati
+# This file id part of the ArduinoLogger library.
+# MIT License, see LICENSE
+#
+# Converts a binary RecordLogger file (RECORD_BINARY) to CSV
+#
+# Usage: record2csv.py LOG.BIN [OUT.CSV]
+
+import struct
+import sys
+
+MAGIC = b"ALRB"
+VERSION = 1
+SYNC = 0xA5
+
+# Column type: struct format (little-endian)
+TYPES = {
+	1: "b",  # RECORD_INT8
+	2: "B",  # RECORD_UINT8
+	3: "h",  # RECORD_INT16
+	4: "H",  # RECORD_UINT16
+	5: "i",  # RECORD_INT32
+	6: "I",  # RECORD_UINT32
+	7: "f",  # RECORD_FLOAT32
+	8: "d",  # RECORD_FLOAT64
+}
+
+
+def read_header(data):
+	if data[:4] != MAGIC:
+		raise ValueError("not a RecordLogger binary file")
+	if data[4] != VERSION:
+		raise ValueError("unsupported version %d" % data[4])
+
+	count = data[5]
+	pos = 6
+	names = []
+	fmt = "<"
+
+	for _ in range(count):
+		kind = data[pos]
+		if kind not in TYPES:
+			raise ValueError("unknown column type %d" % kind)
+		end = data.index(b"\0", pos + 1)
+		names.append(data[pos + 1:end].decode("utf-8", "replace"))
+		fmt += TYPES[kind]
+		pos = end + 1
+
+	return names, struct.Struct(fmt), pos
+
+
+def convert(data, out):
+	names, row, pos = read_header(data)
+	skipped = 0
+
+	out.write(",".join(names) + "\n")
+
+	while pos + 1 + row.size <= len(data):
+		# A row starts with the sync byte, anything else is skipped until the next one
+		if data[pos] != SYNC:
+			pos += 1
+			skipped += 1
+			continue
+
+		values = row.unpack_from(data, pos + 1)
+		out.write(",".join(("%.6g" % v) if isinstance(v, float) else str(v) for v in values) + "\n")
+		pos += 1 + row.size
+
+	if skipped:
+		sys.stderr.write("%d bytes skipped\n" % skipped)
+
+
+def main():
+	if len(sys.argv) < 2:
+		sys.stderr.write("usage: %s LOG.BIN [OUT.CSV]\n" % sys.argv[0])
+		return 1
+
+	with open(sys.argv[1], "rb") as f:
+		data = f.read()
+
+	if len(sys.argv) > 2:
+		with open(sys.argv[2], "w") as out:
+			convert(data, out)
+	else:
+		convert(data, sys.stdout)
+
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
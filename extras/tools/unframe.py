@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2020 Farès Chati
+# This file id part of the ArduinoLogger library.
+# MIT License, see LICENSE
+#
+# Extracts the valid frames of a FramedSink log file in one pass, skipping the damaged regions
+#
+# Usage: unframe.py LOG.TXT [OUT.TXT]
+
+import struct
+import sys
+import zlib
+
+MAGIC = b"\xfe\x4c"
+OVERHEAD = 8  # Magic, length and CRC
+
+
+def unframe(data, out):
+	pos = 0
+	damaged = []  # (offset, length) of the skipped regions
+
+	while True:
+		start = data.find(MAGIC, pos)
+		if start < 0:
+			if pos < len(data):
+				damaged.append((pos, len(data) - pos))
+			break
+
+		if start > pos:
+			damaged.append((pos, start - pos))
+
+		frame_ok = False
+		if start + OVERHEAD <= len(data):
+			(length,) = struct.unpack_from("<H", data, start + 2)
+			end = start + 4 + length
+			if end + 4 <= len(data):
+				(crc,) = struct.unpack_from("<I", data, end)
+				frame_ok = zlib.crc32(data[start + 2:end]) == crc
+
+		if frame_ok:
+			out.write(data[start + 4:end])
+			pos = end + 4
+		else:
+			# Not a frame or a damaged one: the search resumes after its magic
+			damaged.append((start, 2))
+			pos = start + 2
+
+	# Adjacent skipped regions are reported as one
+	merged = []
+	for offset, length in damaged:
+		if merged and merged[-1][0] + merged[-1][1] == offset:
+			merged[-1] = (merged[-1][0], merged[-1][1] + length)
+		else:
+			merged.append((offset, length))
+
+	for offset, length in merged:
+		sys.stderr.write("damaged: %d bytes at offset %d\n" % (length, offset))
+
+	return len(merged)
+
+
+def main():
+	if len(sys.argv) < 2:
+		sys.stderr.write("usage: %s LOG.TXT [OUT.TXT]\n" % sys.argv[0])
+		return 1
+
+	with open(sys.argv[1], "rb") as f:
+		data = f.read()
+
+	if len(sys.argv) > 2:
+		with open(sys.argv[2], "wb") as out:
+			damaged = unframe(data, out)
+	else:
+		damaged = unframe(data, sys.stdout.buffer)
+
+	return 2 if damaged else 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "AL_clock.h"
+
+#if defined(ESP32)
+# include <esp_timer.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+# include <time.h>
+#endif
+
+void logDate (uint32_t sec, LogDate & date)
+{
+	// Civil date from the number of days since 01/01/1970 (Howard Hinnant's algorithm)
+	uint32_t secOfDay  = sec % 86400UL;
+	uint32_t dayNum    = sec / 86400UL + 719468UL;
+	uint32_t era       = dayNum / 146097UL;
+	uint32_t dayOfEra  = dayNum - era * 146097UL;
+	uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+	uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+	uint8_t mp         = (5 * dayOfYear + 2) / 153;
+
+	date.month  = mp < 10 ? mp + 3 : mp - 9;
+	date.day    = dayOfYear - (153 * mp + 2) / 5 + 1;
+	date.year   = yearOfEra + era * 400 + (date.month <= 2);
+	date.hour   = secOfDay / 3600;
+	date.minute = secOfDay / 60 % 60;
+	date.second = secOfDay % 60;
+}
+
+char * logFmtDec (char * ptr, uint32_t n, uint8_t minDigits)
+{
+	char buf[10];
+	char * str = buf + sizeof(buf);
+
+	do
+	{
+		uint32_t m = n;
+		n     /= 10;
+		*--str = m - 10 * n + '0';
+	}
+	while (n || buf + sizeof(buf) - str < minDigits);
+
+	while (str < buf + sizeof(buf))
+		*ptr++ = *str++;
+
+	return ptr;
+}
+
+void MillisClock::now (LogTime & time)
+{
+	uint32_t ms = millis();
+
+	_msec += ms - _last;
+	_last  = ms;
+
+	while (_msec >= 1000)
+	{
+		_msec -= 1000;
+		_sec++;
+	}
+
+	time.sec  = _sec;
+	time.usec = _msec * 1000;
+}
+
+void MicrosClock::now (LogTime & time)
+{
+	uint32_t us = micros();
+
+	_usec += us - _last;
+	_last  = us;
+
+	while (_usec >= 1000000)
+	{
+		_usec -= 1000000;
+		_sec++;
+	}
+
+	time.sec  = _sec;
+	time.usec = _usec;
+}
+
+#if AL_USE_TIMELIB
+
+void TimeLibClock::now (LogTime & time)
+{
+	uint32_t sec = ::now();
+	uint32_t ms  = millis();
+
+	// millis() and now() do not tick together, so the sub-second part is counted from the change of second
+	if (sec != _lastSec)
+	{
+		_lastSec  = sec;
+		_secStart = ms;
+	}
+
+	ms -= _secStart;
+
+	time.sec  = sec;
+	time.usec = (ms > 999 ? 999 : ms) * 1000;
+}
+
+#endif // if AL_USE_TIMELIB
+
+#if defined(ESP32)
+
+void EspTimerClock::now (LogTime & time)
+{
+	uint64_t us = esp_timer_get_time();
+
+	time.sec  = us / 1000000;
+	time.usec = us % 1000000;
+}
+
+#endif // if defined(ESP32)
+
+#if defined(__unix__) || defined(__APPLE__)
+
+void HostClock::now (LogTime & time)
+{
+	struct timespec ts;
+
+	clock_gettime (CLOCK_REALTIME, &ts);
+
+	time.sec  = ts.tv_sec;
+	time.usec = ts.tv_nsec / 1000;
+}
+
+#endif // if defined(__unix__) || defined(__APPLE__)
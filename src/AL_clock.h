@@ -0,0 +1,147 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_CLOCK_H
+#define AL_CLOCK_H
+
+#include <Arduino.h>
+
+// TimeLib is only needed by TimeLibClock, it is used when it is available
+#ifndef AL_USE_TIMELIB
+# if defined(__has_include)
+#  if __has_include(<TimeLib.h>)
+#   define AL_USE_TIMELIB 1
+#  else
+#   define AL_USE_TIMELIB 0
+#  endif
+# else
+#  define AL_USE_TIMELIB 1
+# endif
+#endif
+
+#if AL_USE_TIMELIB
+# include <TimeLib.h>
+#endif
+
+// A point in time: Unix time for calendar clocks, time since boot otherwise
+struct LogTime
+{
+	uint32_t sec;  // Seconds
+	uint32_t usec; // Microseconds in the current second (0 - 999999)
+};
+
+// Calendar date and time
+struct LogDate
+{
+	uint16_t year;
+	uint8_t month;  // 1 - 12
+	uint8_t day;    // 1 - 31
+	uint8_t hour;   // 0 - 23
+	uint8_t minute; // 0 - 59
+	uint8_t second; // 0 - 59
+};
+
+// Converts a Unix time to a calendar date
+void logDate (uint32_t sec, LogDate & date);
+
+// Writes n in decimal with at least minDigits digits, returns the end of the number
+char * logFmtDec (char * ptr, uint32_t n, uint8_t minDigits = 1);
+
+// Source of the time displayed in the prefix
+class LogClock
+{
+public:
+	// Reads the seconds and the sub-second part of the time in a single call
+	virtual void now (LogTime & time) = 0;
+};
+
+// Time since boot from millis(), needs to be read at least every 49 days
+class MillisClock : public LogClock
+{
+public:
+	MillisClock() : _sec (0), _msec (0), _last (0){ }
+
+	void now (LogTime & time);
+
+private:
+	uint32_t _sec;
+	uint32_t _msec;
+	uint32_t _last;
+};
+
+// Time since boot from micros(), needs to be read at least every 71 minutes
+class MicrosClock : public LogClock
+{
+public:
+	MicrosClock() : _sec (0), _usec (0), _last (0){ }
+
+	void now (LogTime & time);
+
+private:
+	uint32_t _sec;
+	uint32_t _usec;
+	uint32_t _last;
+};
+
+#if AL_USE_TIMELIB
+
+// Unix time from TimeLib, with milliseconds counted from the last second change
+class TimeLibClock : public LogClock
+{
+public:
+	TimeLibClock() : _lastSec (0), _secStart (0){ }
+
+	void now (LogTime & time);
+
+private:
+	uint32_t _lastSec;
+	uint32_t _secStart;
+};
+
+#endif // if AL_USE_TIMELIB
+
+#if defined(ESP32)
+
+// Time since boot from the 64 bits esp_timer
+class EspTimerClock : public LogClock
+{
+public:
+	void now (LogTime & time);
+};
+
+#endif // if defined(ESP32)
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// Unix time from clock_gettime, for builds running on a host computer
+class HostClock : public LogClock
+{
+public:
+	void now (LogTime & time);
+};
+
+#endif // if defined(__unix__) || defined(__APPLE__)
+
+#endif // ifndef AL_CLOCK_H
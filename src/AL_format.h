@@ -0,0 +1,373 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_FORMAT_H
+#define AL_FORMAT_H
+
+#include <ArduinoLogger.h>
+#include <AL_traits.h>
+
+/**
+ * printf-style logging, the format string is parsed at compile time:
+ *
+ * LOGF (inf, "temp=%.1f rpm=%u", t, r);
+ * LOGF (LOG_LEVEL_INFO, "temp=%.1f rpm=%u", t, r);
+ *
+ * The first argument is a logger or a level of the global loggers. The line is terminated by the macro.
+ * The format string must be a string literal, it is turned into a sequence of writes of its literal parts
+ * and insertions of the arguments: a wrong number of arguments or a wrong argument type does not compile.
+ *
+ * Conversions: %d %i %u %x %X %o %b (binary) %c %s %f %F %e %E %g %G (all fixed-point) %p %%
+ * Flags: - + 0 #, width is supported, precision only on the floating-point conversions (%.3s does not compile).
+ * Length modifiers (l, h, z...) are accepted and ignored, 64 bits integers do not compile.
+ * The format of the logger (flags, fill, precision) is restored at the end of the line.
+ */
+#define LOGF(target, format, ...) \
+	al_format::print ([] () { \
+		struct Format { static constexpr const char * str (){ return format; } }; \
+		return Format(); \
+	} (), al_format::logger (target), ## __VA_ARGS__)
+
+namespace al_format {
+// ------------------------------------------------------------------------------ Logger selection
+
+inline ArduinoLogger & logger (ArduinoLogger & logger)
+{
+	return logger;
+}
+
+inline ArduinoLogger & logger (int level)
+{
+	return levelLogger (level);
+}
+
+// ------------------------------------------------------------------------------ Format string parsing
+
+constexpr bool isDigit (char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+constexpr bool isFlag (char c)
+{
+	return c == '-' || c == '+' || c == '0' || c == '#' || c == ' ';
+}
+
+constexpr bool isLength (char c)
+{
+	return c == 'l' || c == 'h' || c == 'z' || c == 'j' || c == 't' || c == 'L';
+}
+
+// End of the literal text starting at i
+constexpr size_t literalEnd (const char * f, size_t i)
+{
+	return f[i] == '\0' || f[i] == '%' ? i : literalEnd (f, i + 1);
+}
+
+constexpr size_t skipFlags (const char * f, size_t i)
+{
+	return isFlag (f[i]) ? skipFlags (f, i + 1) : i;
+}
+
+constexpr size_t skipDigits (const char * f, size_t i)
+{
+	return isDigit (f[i]) ? skipDigits (f, i + 1) : i;
+}
+
+constexpr size_t skipLength (const char * f, size_t i)
+{
+	return isLength (f[i]) ? skipLength (f, i + 1) : i;
+}
+
+constexpr bool hasFlag (const char * f, size_t i, size_t end, char flag)
+{
+	return i < end && (f[i] == flag || hasFlag (f, i + 1, end, flag));
+}
+
+constexpr unsigned parseNumber (const char * f, size_t i, unsigned n = 0)
+{
+	return isDigit (f[i]) ? parseNumber (f, i + 1, n * 10 + f[i] - '0') : n;
+}
+
+// What is found at the end of a literal text
+enum Token { END, PERCENT, SPEC };
+
+constexpr Token token (const char * f, size_t i)
+{
+	return f[i] == '\0' ? END : f[i + 1] == '%' ? PERCENT : SPEC;
+}
+
+// Conversion specification starting at the '%' at index I of the format string
+template <class F, size_t I>
+struct Spec
+{
+	static constexpr size_t flagsEnd     = skipFlags (F::str (), I + 1);
+	static constexpr size_t widthEnd     = skipDigits (F::str (), flagsEnd);
+	static constexpr bool hasPrecision   = F::str ()[widthEnd] == '.';
+	static constexpr size_t precisionEnd = hasPrecision ? skipDigits (F::str (), widthEnd + 1) : widthEnd;
+	static constexpr size_t lengthEnd    = skipLength (F::str (), precisionEnd);
+
+	static constexpr char conversion = F::str ()[lengthEnd];
+	static constexpr size_t end      = lengthEnd + 1;
+
+	static constexpr bool left         = hasFlag (F::str (), I + 1, flagsEnd, '-');
+	static constexpr bool plus         = hasFlag (F::str (), I + 1, flagsEnd, '+');
+	static constexpr bool zero         = hasFlag (F::str (), I + 1, flagsEnd, '0');
+	static constexpr bool alternate    = hasFlag (F::str (), I + 1, flagsEnd, '#');
+	static constexpr unsigned width    = parseNumber (F::str (), flagsEnd);
+	static constexpr unsigned precision = parseNumber (F::str (), widthEnd + 1);
+};
+
+// ------------------------------------------------------------------------------ Argument types
+
+template <class T> struct Decay { typedef T type; };
+template <class T> struct Decay<const T> { typedef typename Decay<T>::type type; };
+template <class T> struct Decay<volatile T> { typedef typename Decay<T>::type type; };
+template <class T> struct Decay<const volatile T> { typedef typename Decay<T>::type type; };
+template <class T, size_t N> struct Decay<T[N]> { typedef const T * type; };
+
+template <class T> struct IsString { static constexpr bool value = false; };
+template <> struct IsString<char *> { static constexpr bool value = true; };
+template <> struct IsString<const char *> { static constexpr bool value = true; };
+template <> struct IsString<const __FlashStringHelper *> { static constexpr bool value = true; };
+template <> struct IsString<String> { static constexpr bool value = true; };
+
+template <class T> struct IsPointer { static constexpr bool value = false; };
+template <class T> struct IsPointer<T *> { static constexpr bool value = true; };
+
+// Kind of argument expected by a conversion
+enum Kind { INTEGER, UNSIGNED, CHARACTER, FLOATING, STRING, POINTER, INVALID };
+
+constexpr Kind kind (char conversion)
+{
+	return conversion == 'd' || conversion == 'i' ? INTEGER :
+	       conversion == 'u' || conversion == 'x' || conversion == 'X' || conversion == 'o' ||
+	       conversion == 'b' ? UNSIGNED :
+	       conversion == 'c' ? CHARACTER :
+	       conversion == 'f' || conversion == 'F' || conversion == 'e' || conversion == 'E' ||
+	       conversion == 'g' || conversion == 'G' ? FLOATING :
+	       conversion == 's' ? STRING :
+	       conversion == 'p' ? POINTER : INVALID;
+}
+
+template <Kind K, class T>
+struct Accepts { static constexpr bool value = false; };
+template <class T>
+struct Accepts<INTEGER, T> { static constexpr bool value = al_traits::IsIntegral<T>::value; };
+template <class T>
+struct Accepts<UNSIGNED, T> { static constexpr bool value = al_traits::IsIntegral<T>::value; };
+template <class T>
+struct Accepts<CHARACTER, T> { static constexpr bool value = al_traits::IsIntegral<T>::value; };
+template <class T>
+struct Accepts<FLOATING, T> { static constexpr bool value = al_traits::IsFloat<T>::value; };
+template <class T>
+struct Accepts<STRING, T> { static constexpr bool value = IsString<T>::value; };
+template <class T>
+struct Accepts<POINTER, T> { static constexpr bool value = IsPointer<T>::value; };
+
+// ------------------------------------------------------------------------------ Arguments output
+
+template <Kind K>
+struct Insert;
+
+template <>
+struct Insert<INTEGER>
+{
+	template <class T>
+	static void run (ostream & os, const T & arg)
+	{
+		if (T (-1) < T (0))
+			os << (long) arg;
+		else
+			os << (unsigned long) arg;
+	}
+};
+
+// %u %x %X %o %b print the value as an unsigned integer of its own size: -1 is 0xFF for an int8_t
+template <size_t Size>
+struct UnsignedOf { typedef uint32_t type; };
+template <>
+struct UnsignedOf<1> { typedef uint8_t type; };
+template <>
+struct UnsignedOf<2> { typedef uint16_t type; };
+
+template <>
+struct Insert<UNSIGNED>
+{
+	template <class T>
+	static void run (ostream & os, const T & arg)
+	{
+		os << (unsigned long) (typename UnsignedOf<sizeof(T)>::type) arg;
+	}
+};
+
+template <>
+struct Insert<CHARACTER>
+{
+	template <class T>
+	static void run (ostream & os, const T & arg)
+	{
+		os << (char) arg;
+	}
+};
+
+template <>
+struct Insert<FLOATING>
+{
+	template <class T>
+	static void run (ostream & os, const T & arg)
+	{
+		os << (double) arg;
+	}
+};
+
+template <>
+struct Insert<STRING>
+{
+	template <class T>
+	static void run (ostream & os, const T & arg)
+	{
+		os << arg;
+	}
+};
+
+template <>
+struct Insert<POINTER>
+{
+	template <class T>
+	static void run (ostream & os, const T & arg)
+	{
+		os << (const void *) arg;
+	}
+};
+
+// Stream flags of a conversion specification
+template <class S>
+inline void applySpec (ostream & os)
+{
+	ios_base::fmtflags flags = ios_base::skipws | ios_base::boolalpha;
+
+	flags |= S::left ? ios_base::left : S::zero ? ios_base::internal : ios_base::right;
+	flags |= S::conversion == 'x' || S::conversion == 'X' || S::conversion == 'p' ? ios_base::hex :
+	  S::conversion == 'o' ? ios_base::oct :
+	  S::conversion == 'b' ? ios_base::bin : ios_base::dec;
+	if (S::conversion == 'X' || S::conversion == 'E' || S::conversion == 'G')
+		flags |= ios_base::uppercase;
+	if (S::plus)
+		flags |= ios_base::showpos;
+	if (S::alternate || S::conversion == 'p')
+		flags |= ios_base::showbase | ios_base::showpoint;
+
+	os.flags (flags);
+	os.fill (S::zero && !S::left ? '0' : ' ');
+	os.width (S::width);
+	if (kind (S::conversion) == FLOATING)
+		os.precision (S::hasPrecision ? S::precision : 6);
+}
+
+// ------------------------------------------------------------------------------ Format string walk
+
+template <class F, size_t I, class ... Args>
+void printFrom (ArduinoLogger & os, const Args & ... args);
+
+template <class F, size_t I, Token T, class ... Args>
+struct Step;
+
+template <class F, size_t I, class ... Args>
+struct Step<F, I, END, Args ...>
+{
+	static_assert (sizeof ... (Args) == 0, "LOGF: too many arguments for the format string");
+
+	static void run (ArduinoLogger & os, const Args & ... args)
+	{
+		endl (os);
+	}
+};
+
+template <class F, size_t I, class ... Args>
+struct Step<F, I, PERCENT, Args ...>
+{
+	static void run (ArduinoLogger & os, const Args & ... args)
+	{
+		os.put ('%');
+		printFrom<F, I + 2>(os, args ...);
+	}
+};
+
+template <class F, size_t I>
+struct Step<F, I, SPEC>
+{
+	static_assert (sizeof(F) == 0, "LOGF: not enough arguments for the format string");
+
+	static void run (ArduinoLogger & os){ }
+};
+
+template <class F, size_t I, class Arg, class ... Args>
+struct Step<F, I, SPEC, Arg, Args ...>
+{
+	typedef Spec<F, I> S;
+	typedef typename Decay<Arg>::type Type;
+
+	static_assert (kind (S::conversion) != INVALID, "LOGF: unknown conversion in the format string");
+	static_assert (Accepts<kind (S::conversion), Type>::value, "LOGF: argument type does not match the conversion");
+	static_assert (!al_traits::IsIntegral<Type>::value || sizeof(Type) <= 4, "LOGF: 64 bits integers are not supported");
+	static_assert (!S::hasPrecision || kind (S::conversion) == FLOATING, "LOGF: precision is only supported on floating-point conversions");
+
+	static void run (ArduinoLogger & os, const Arg & arg, const Args & ... args)
+	{
+		applySpec<S>(os);
+		Insert<kind (S::conversion)>::run (os, arg);
+		printFrom<F, S::end>(os, args ...);
+	}
+};
+
+template <class F, size_t I, class ... Args>
+inline void printFrom (ArduinoLogger & os, const Args & ... args)
+{
+	constexpr size_t end = literalEnd (F::str (), I);
+
+	if (end > I)
+		os.write (F::str () + I, end - I);
+
+	Step<F, end, token (F::str (), end), Args ...>::run (os, args ...);
+}
+
+template <class F, class ... Args>
+inline void print (F, ArduinoLogger & os, const Args & ... args)
+{
+	// The conversions change the stream format, it is restored for the next lines
+	ios_base::fmtflags flags = os.flags();
+	char fill     = os.fill();
+	int precision = os.precision();
+
+	printFrom<F, 0>(os, args ...);
+
+	os.flags (flags);
+	os.fill (fill);
+	os.precision (precision);
+}
+} // namespace al_format
+
+#endif // ifndef AL_FORMAT_H
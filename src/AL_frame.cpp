@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "AL_frame.h"
+
+#define CRC32_POLYNOMIAL 0xEDB88320 // Reflected
+
+#if AL_CRC_SLICE_BY_4
+
+static uint32_t crcTables[4][256];
+
+// Tables of the CRC of one byte followed by 0 to 3 zero bytes
+static void initCrcTables ()
+{
+	for (uint16_t i = 0; i < 256; i++)
+	{
+		uint32_t crc = i;
+
+		for (uint8_t bit = 0; bit < 8; bit++)
+			crc = crc & 1 ? (crc >> 1) ^ CRC32_POLYNOMIAL : crc >> 1;
+		crcTables[0][i] = crc;
+	}
+
+	for (uint16_t i = 0; i < 256; i++)
+		for (uint8_t t = 1; t < 4; t++)
+			crcTables[t][i] = (crcTables[t - 1][i] >> 8) ^ crcTables[0][crcTables[t - 1][i] & 0xFF];
+}
+
+uint32_t logCrc32 (uint32_t crc, const void * data, size_t len)
+{
+	const uint8_t * ptr = (const uint8_t *) data;
+
+	if (!crcTables[0][1])
+		initCrcTables();
+
+	crc = ~crc;
+
+	// 4 bytes per step
+	for (; len >= 4; len -= 4, ptr += 4)
+	{
+		crc ^= (uint32_t) ptr[0] | (uint32_t) ptr[1] << 8 | (uint32_t) ptr[2] << 16 | (uint32_t) ptr[3] << 24;
+		crc  = crcTables[3][crc & 0xFF] ^ crcTables[2][(crc >> 8) & 0xFF]
+		  ^ crcTables[1][(crc >> 16) & 0xFF] ^ crcTables[0][crc >> 24];
+	}
+
+	while (len--)
+		crc = (crc >> 8) ^ crcTables[0][(crc ^ *ptr++) & 0xFF];
+
+	return ~crc;
+}
+
+#else // if AL_CRC_SLICE_BY_4
+
+// CRC of each nibble
+static const uint32_t crcNibbles[16] PROGMEM = {
+	0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+	0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+uint32_t logCrc32 (uint32_t crc, const void * data, size_t len)
+{
+	const uint8_t * ptr = (const uint8_t *) data;
+
+	crc = ~crc;
+
+	while (len--)
+	{
+		crc ^= *ptr++;
+		crc  = (crc >> 4) ^ pgm_read_dword (&crcNibbles[crc & 0x0F]);
+		crc  = (crc >> 4) ^ pgm_read_dword (&crcNibbles[crc & 0x0F]);
+	}
+
+	return ~crc;
+}
+
+#endif // if AL_CRC_SLICE_BY_4
+
+FramedSink::FramedSink (Print & target) : _target (target), _inLine (false), _length (0)
+{ }
+
+void FramedSink::beginLine (uint8_t level)
+{
+	(void) level;
+	_inLine = true;
+}
+
+void FramedSink::endLine ()
+{
+	writeFrame();
+	_inLine = false;
+}
+
+size_t FramedSink::write (uint8_t c)
+{
+	return write (&c, 1);
+}
+
+size_t FramedSink::write (const uint8_t * buffer, size_t size)
+{
+	for (size_t left = size; left;)
+	{
+		if (_length == sizeof(_buffer))
+			writeFrame();
+
+		size_t chunk = sizeof(_buffer) - _length < left ? sizeof(_buffer) - _length : left;
+
+		memcpy (_buffer + _length, buffer, chunk);
+		_length += chunk;
+		buffer  += chunk;
+		left    -= chunk;
+	}
+
+	// Outside of a line (e.g. flight recorder dump), each block is a frame
+	if (!_inLine)
+		writeFrame();
+
+	return size;
+}
+
+void FramedSink::writeFrame ()
+{
+	if (!_length)
+		return;
+
+	uint8_t header[4] = { FRAME_MAGIC0, FRAME_MAGIC1, (uint8_t) _length, (uint8_t) (_length >> 8) };
+	uint32_t crc      = logCrc32 (logCrc32 (0, header + 2, 2), _buffer, _length);
+	uint8_t trailer[4] = { (uint8_t) crc, (uint8_t) (crc >> 8), (uint8_t) (crc >> 16), (uint8_t) (crc >> 24) };
+
+	_target.write (header, sizeof(header));
+	_target.write (_buffer, _length);
+	_target.write (trailer, sizeof(trailer));
+
+	_length = 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_FRAME_H
+#define AL_FRAME_H
+
+#include <ArduinoLogger.h>
+
+// Maximum payload of a frame, a longer line is split in several frames
+#ifndef AL_FRAME_BUFFER_SIZE
+# define AL_FRAME_BUFFER_SIZE 256
+#endif
+
+// CRC32 with 4 tables of 256 entries (4 KB of RAM) instead of a 16 entries table
+#ifndef AL_CRC_SLICE_BY_4
+# if defined(__AVR__) || defined(ESP8266)
+#  define AL_CRC_SLICE_BY_4 0
+# else
+#  define AL_CRC_SLICE_BY_4 1
+# endif
+#endif
+
+#define FRAME_MAGIC0   0xFE // 0xFE never appears in UTF-8 text, but may in binary payloads
+#define FRAME_MAGIC1   0x4C
+#define FRAME_OVERHEAD 8 // Magic, length and CRC
+
+// CRC-32 (IEEE 802.3, as zlib), crc is 0 for the first block
+uint32_t logCrc32 (uint32_t crc, const void * data, size_t len);
+
+/**
+ * Output wrapping each line in a frame, for log files that can be checked and repaired:
+ *
+ * FramedSink framedLog (logFile);
+ * logger.add (framedLog, LOG_LEVEL_VERBOSE);
+ *
+ * A frame is FRAME_MAGIC0, FRAME_MAGIC1, the payload length (16 bits), the payload and the CRC-32 of the
+ * length and the payload (32 bits), in little-endian order. extras/tools/unframe.py extracts the valid
+ * frames of a file and reports the damaged regions.
+ * After a damaged region, the next frame is found by its magic bytes: with text lines they only appear at
+ * the start of a frame. A binary payload (e.g. a RecordLogger in RECORD_BINARY) can contain them, so the
+ * resync may first try a false frame start, which its CRC rejects, before finding the real one.
+ */
+class FramedSink : public LogSink
+{
+public:
+	explicit FramedSink(Print & target);
+
+	void beginLine (uint8_t level);
+	void endLine ();
+
+	size_t write (uint8_t c);
+	size_t write (const uint8_t * buffer, size_t size);
+	using Print::write;
+
+private:
+	static_assert (AL_FRAME_BUFFER_SIZE <= 0xFFFF, "AL_FRAME_BUFFER_SIZE does not fit the 16 bits length of a frame");
+
+	void writeFrame ();
+
+	Print & _target;
+	bool _inLine;
+	uint16_t _length;
+	uint8_t _buffer[AL_FRAME_BUFFER_SIZE];
+};
+
+#endif // ifndef AL_FRAME_H
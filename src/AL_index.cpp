@@ -0,0 +1,96 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "AL_index.h"
+
+IndexedSink::IndexedSink (Print & log, Print & index, LogClock & clock, uint32_t offset) :
+	_log (log), _index (index), _clock (clock), _offset (offset),
+	_intervalBytes (4096), _intervalSeconds (60), _last(), _empty (true), _nPending (0)
+{ }
+
+void IndexedSink::setInterval (uint32_t bytes, uint32_t seconds)
+{
+	_intervalBytes   = bytes;
+	_intervalSeconds = seconds;
+}
+
+void IndexedSink::writeIndex ()
+{
+	uint8_t entries[AL_INDEX_BATCH * 8];
+	uint8_t * ptr = entries;
+
+	for (uint8_t i = 0; i < _nPending; i++)
+	{
+		uint32_t time   = _pending[i].time;
+		uint32_t offset = _pending[i].offset;
+
+		for (uint8_t b = 0; b < 4; b++, time >>= 8)
+			*ptr++ = time;
+		for (uint8_t b = 0; b < 4; b++, offset >>= 8)
+			*ptr++ = offset;
+	}
+
+	_index.write (entries, ptr - entries);
+	_nPending = 0;
+}
+
+void IndexedSink::beginLine (uint8_t level)
+{
+	(void) level;
+
+	LogTime time;
+
+	_clock.now (time);
+
+	// A clock set back starts a new run of increasing times in the index
+	bool setBack = !_empty && time.sec < _last.time;
+
+	if (_empty || setBack || _offset - _last.offset >= _intervalBytes || time.sec - _last.time >= _intervalSeconds)
+	{
+		_last.time   = time.sec;
+		_last.offset = _offset;
+		_empty       = false;
+
+		_pending[_nPending++] = _last;
+	}
+
+	// By batches, or once the oldest entry waited for the interval so that a power loss loses few of them
+	if (_nPending == AL_INDEX_BATCH || setBack || (_nPending && time.sec - _pending[0].time >= _intervalSeconds))
+		writeIndex();
+}
+
+size_t IndexedSink::write (uint8_t c)
+{
+	return write (&c, 1);
+}
+
+size_t IndexedSink::write (const uint8_t * buffer, size_t size)
+{
+	size_t written = _log.write (buffer, size);
+
+	_offset += written;
+
+	return written;
+}
@@ -0,0 +1,84 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_INDEX_H
+#define AL_INDEX_H
+
+#include <ArduinoLogger.h>
+
+// Number of index entries written at once
+#ifndef AL_INDEX_BATCH
+# define AL_INDEX_BATCH 8
+#endif
+
+// Position of a line in the log file
+struct LogIndexEntry
+{
+	uint32_t time;   // Seconds of the clock of the index
+	uint32_t offset; // Offset of the first character of the line
+};
+
+/**
+ * Output writing the lines to a log file and keeping a sparse index of the file in another one:
+ *
+ * IndexedSink indexedLog (logFile, indexFile, clock, logFile.size ());
+ * logger.add (indexedLog, LOG_LEVEL_VERBOSE);
+ *
+ * An entry is added for the first line after interval bytes or seconds since the previous one.
+ * The entries are written by batches of AL_INDEX_BATCH, or once the oldest one is interval seconds old:
+ * call writeIndex () before closing the index file.
+ * The index file is a sequence of entries of 8 bytes: time and offset, 32 bits little-endian each.
+ * extras/tools/logindex.py uses it to output the lines of a time window without reading the whole log.
+ * When the clock is set back, an entry is added and written at once: the index is then made of runs of
+ * increasing times, which logindex.py searches one by one.
+ */
+class IndexedSink : public LogSink
+{
+public:
+	IndexedSink(Print & log, Print & index, LogClock & clock, uint32_t offset = 0);
+
+	void setInterval (uint32_t bytes, uint32_t seconds); // Default is 4096 bytes or 60 seconds
+	void writeIndex ();                                  // Writes the pending index entries
+
+	void beginLine (uint8_t level);
+
+	size_t write (uint8_t c);
+	size_t write (const uint8_t * buffer, size_t size);
+	using Print::write;
+
+private:
+	Print & _log;
+	Print & _index;
+	LogClock & _clock;
+	uint32_t _offset; // Offset of the next character in the log file
+	uint32_t _intervalBytes;
+	uint32_t _intervalSeconds;
+	LogIndexEntry _last; // Last entry added
+	bool _empty;         // No entry added yet
+	uint8_t _nPending;
+	LogIndexEntry _pending[AL_INDEX_BATCH];
+};
+
+#endif // ifndef AL_INDEX_H
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ArduinoLogger.h"
+
+IsrLogQueue isrLogQueue;
+
+bool IsrLogQueue::pop (IsrLogRecord & record)
+{
+	uint8_t tail = _tail;
+
+	if (tail == _head)
+		return false;
+
+	AL_MEMORY_BARRIER();
+	record = _records[tail & (AL_ISR_QUEUE_SIZE - 1)];
+	AL_MEMORY_BARRIER();
+	_tail = tail + 1;
+
+	return true;
+}
+
+uint16_t IsrLogQueue::lost ()
+{
+	uint16_t overflows;
+
+	// 16 bits are not read atomically on AVR
+	noInterrupts();
+	overflows = _overflows;
+	interrupts();
+
+	uint16_t lost = overflows - _reported;
+
+	_reported = overflows;
+
+	return lost;
+}
+
+uint8_t ArduinoLogger::poll () const
+{
+	IsrLogRecord record;
+	uint8_t n     = 0;
+	uint16_t lost = isrLogQueue.lost();
+
+	if (lost)
+	{
+		ArduinoLogger out (LOG_LEVEL_WARNING, *_registry);
+
+		out << F ("ISR log queue full, ") << lost << F (" lines lost") << endl;
+	}
+
+	while (isrLogQueue.pop (record))
+	{
+		ArduinoLogger out (record.level, *_registry);
+
+		out << F ("ISR #") << record.id << F (" @") << record.time << F ("us");
+
+		for (uint8_t i = 0; i < record.nArgs; i++)
+		{
+			out << (i ? " " : ": ");
+
+			if (record.signs & 1 << i)
+				out << (int32_t) record.args[i];
+			else
+				out << record.args[i];
+		}
+
+		out << endl;
+		n++;
+	}
+
+	return n;
+}
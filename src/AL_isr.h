@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_ISR_H
+#define AL_ISR_H
+
+#include <Arduino.h>
+#include <AL_traits.h>
+
+// Number of records of the interrupt queue, must be a power of 2 up to 128
+#ifndef AL_ISR_QUEUE_SIZE
+# define AL_ISR_QUEUE_SIZE 16
+#endif
+
+// Maximum number of arguments of an interrupt record, up to 8
+#ifndef AL_ISR_MAX_ARGS
+# define AL_ISR_MAX_ARGS 3
+#endif
+
+#if defined(__AVR__)
+# define AL_MEMORY_BARRIER() __asm__ __volatile__ ("" ::: "memory")
+#else
+# define AL_MEMORY_BARRIER() __sync_synchronize()
+#endif
+
+// Raw log line recorded in an interrupt, formatted later
+struct IsrLogRecord
+{
+	uint32_t time;                  // micros() when the record was queued
+	uint16_t id;                    // Message identifier
+	uint8_t  level;                 // Log level
+	uint8_t  nArgs;                 // Number of arguments
+	uint8_t  signs;                 // Bit i is set when argument i is signed
+	uint32_t args[AL_ISR_MAX_ARGS]; // Raw arguments
+};
+
+// Lock-free queue with a single producer (interrupts) and a single consumer (loop)
+// It has no constructor so that a global queue is zeroed before any interrupt can use it
+class IsrLogQueue
+{
+	static_assert ((AL_ISR_QUEUE_SIZE & (AL_ISR_QUEUE_SIZE - 1)) == 0 && AL_ISR_QUEUE_SIZE <= 128,
+	  "AL_ISR_QUEUE_SIZE must be a power of 2 up to 128");
+	static_assert (AL_ISR_MAX_ARGS <= 8, "AL_ISR_MAX_ARGS must be up to 8");
+
+public:
+	// Producer side, never blocks: the record is dropped and counted if the queue is full
+	inline void push (uint8_t level, uint16_t id, uint8_t nArgs, uint8_t signs, const uint32_t * args)
+	{
+		uint8_t head = _head;
+
+		if ((uint8_t) (head - _tail) >= AL_ISR_QUEUE_SIZE)
+		{
+			_overflows++;
+			return;
+		}
+
+		IsrLogRecord & record = _records[head & (AL_ISR_QUEUE_SIZE - 1)];
+
+		record.time  = micros();
+		record.id    = id;
+		record.level = level;
+		record.nArgs = nArgs;
+		record.signs = signs;
+		for (uint8_t i = 0; i < nArgs; i++)
+			record.args[i] = args[i];
+
+		AL_MEMORY_BARRIER();
+		_head = head + 1;
+	}
+
+	// Consumer side
+	bool pop (IsrLogRecord & record);
+	uint16_t lost (); // Number of records dropped since the last call
+
+private:
+	IsrLogRecord _records[AL_ISR_QUEUE_SIZE];
+	volatile uint8_t _head;
+	volatile uint8_t _tail;
+	volatile uint16_t _overflows;
+	uint16_t _reported;
+};
+
+extern IsrLogQueue isrLogQueue;
+
+// Signedness of the arguments of an interrupt record, bit i for argument i
+template <class ... Args>
+struct IsrLogSigns { static constexpr uint8_t value = 0; };
+template <class T, class ... Args>
+struct IsrLogSigns<T, Args ...>
+{
+	static constexpr uint8_t value = (al_traits::Number<T>::isSigned ? 1 : 0) | IsrLogSigns<Args ...>::value << 1;
+};
+
+// Queues a log line from an interrupt handler, it is output by logger.poll()
+// e.g. isrLog (LOG_LEVEL_WARNING, 12, TCNT1, errorCount);
+// Arguments are integers, stored as raw 32 bits values with their signedness
+template <class ... Args>
+inline void isrLog (uint8_t level, uint16_t id, Args ... args)
+{
+	static_assert (sizeof ... (Args) <= AL_ISR_MAX_ARGS, "isrLog: too many arguments, see AL_ISR_MAX_ARGS");
+
+	const uint32_t values[sizeof ... (Args) + 1] = { (uint32_t) args ..., 0 };
+
+	isrLogQueue.push (level, id, sizeof ... (Args), IsrLogSigns<Args ...>::value, values);
+}
+
+#endif // ifndef AL_ISR_H
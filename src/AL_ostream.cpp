@@ -31,12 +31,15 @@
 #ifndef PSTR
 # define PSTR(x) x
 #endif
+
+static const char hexDigitsUpper[] = "0123456789ABCDEF";
+static const char hexDigitsLower[] = "0123456789abcdef";
 // ------------------------------------------------------------------------------
 void ostream::do_fill (unsigned len)
 {
-	for (; len < width(); len++)
+	if (len < width())
 	{
-		putch (fill());
+		putFill (width() - len);
 	}
 	width (0);
 }
@@ -100,6 +103,73 @@ void ostream::putBool (bool b)
 	}
 }
 
+// ------------------------------------------------------------------------------
+void ostream::putBytes (const uint8_t * data, size_t len)
+{
+	const char * digits = flags() & uppercase ? hexDigitsUpper : hexDigitsLower;
+	char buf[16 * 3];
+
+	while (len)
+	{
+		char * ptr = buf;
+
+		for (; len && ptr < buf + sizeof(buf); len--)
+		{
+			*ptr++ = digits[*data >> 4];
+			*ptr++ = digits[*data++ & 0x0F];
+			*ptr++ = ' ';
+		}
+		// the separator after the last byte is not output
+		putstr (buf, ptr - buf - (len ? 0 : 1));
+	}
+}
+
+// ------------------------------------------------------------------------------
+void ostream::putHexDump (const uint8_t * data, size_t len)
+{
+	const char * digits  = flags() & uppercase ? hexDigitsUpper : hexDigitsLower;
+	uint8_t offsetDigits = len > 0x10000 ? 8 : 4;
+	char row[8 + 2 + 16 * 3 + 1 + 16 + 2]; // offset, ": ", bytes, "|", ASCII, "|\n"
+
+	for (size_t offset = 0; offset < len; offset += 16)
+	{
+		size_t n     = len - offset < 16 ? len - offset : 16;
+		char * ptr   = row + offsetDigits;
+		char * ascii = row + offsetDigits + 2 + 16 * 3 + 1;
+
+		for (size_t o = offset; ptr > row; o >>= 4)
+		{
+			*--ptr = digits[o & 0x0F];
+		}
+		ptr   += offsetDigits;
+		*ptr++ = ':';
+		*ptr++ = ' ';
+		for (size_t i = 0; i < 16; i++)
+		{
+			if (i < n)
+			{
+				uint8_t b = data[offset + i];
+				*ptr++   = digits[b >> 4];
+				*ptr++   = digits[b & 0x0F];
+				*ascii++ = b >= 0x20 && b < 0x7F ? b : '.';
+			}
+			else
+			{
+				*ptr++ = ' ';
+				*ptr++ = ' ';
+			}
+			*ptr++ = ' ';
+		}
+		*ptr++   = '|';
+		*ascii++ = '|';
+		if (offset + 16 < len)
+		{
+			*ascii++ = '\n';
+		}
+		putstr (row, ascii - row);
+	}
+} // ostream::putHexDump
+
 // ------------------------------------------------------------------------------
 void ostream::putChar (char c)
 {
@@ -114,13 +184,10 @@ void ostream::putDouble (double n)
 	uint8_t nd   = precision();
 	double round = 0.5;
 	char sign;
-	char buf[13]; // room for sign, 10 digits, '.', and zero byte
-	char * end = buf + sizeof(buf) - 1;
+	char buf[12 + 8]; // room for sign, 10 digits, '.', and 8 fraction digits
+	char * end = buf + 12;
 	char * str = end;
 
-	// terminate string
-	*end = '\0';
-
 	// get sign and make nonnegative
 	if (n < 0.0)
 	{
@@ -176,42 +243,119 @@ void ostream::putDouble (double n)
 			*--str = sign;
 		}
 	}
-	putstr (str);
-	// output fraction
-	while (nd-- > 0)
+	// output fraction along with the integer part, in chunks of 8 digits
+	do
 	{
-		fractionPart *= 10.0;
-		int digit = static_cast<int>(fractionPart);
-		putch (digit + '0');
-		fractionPart -= digit;
+		char * frac = end;
+		for (; nd > 0 && frac < buf + sizeof(buf); nd--)
+		{
+			fractionPart *= 10.0;
+			int digit = static_cast<int>(fractionPart);
+			*frac++ = digit + '0';
+			fractionPart -= digit;
+		}
+		putstr (str, frac - str);
+		str = end;
 	}
+	while (nd > 0);
 	// do fill if not done above
 	do_fill (len);
 } // ostream::putDouble
 
 // ------------------------------------------------------------------------------
-void ostream::putNum (int32_t n)
+void ostream::putFixed (int32_t value, uint8_t scale)
 {
-	bool neg = n < 0 && flagsToBase() == 10;
+	uint8_t nd = precision();
+	uint32_t n = value < 0 ? 0 - (uint32_t) value : value;
+	uint32_t divisor = 1;
+	char sign;
+	char buf[12 + 9]; // room for sign, 10 digits, '.', and 9 fraction digits
+	char * end = buf + 12;
+	char * str = end;
 
-	if (neg)
+	if (value < 0)
 	{
-		n = -n;
+		sign = '-';
 	}
-	putNum (n, neg);
-}
+	else
+	{
+		sign = flags() & showpos ? '+' : '\0';
+	}
+	if (scale > 9)
+	{
+		scale = 9;
+	}
+	// round half up to the displayed digits
+	if (nd < scale)
+	{
+		for (uint8_t i = nd; i < scale; ++i)
+		{
+			divisor *= 10;
+		}
+		uint32_t rest = n % divisor;
+		n = n / divisor + (rest >= divisor / 2 ? 1 : 0);
+		scale   = nd;
+		divisor = 1;
+	}
+	for (uint8_t i = 0; i < scale; ++i)
+	{
+		divisor *= 10;
+	}
+	uint32_t intPart  = n / divisor;
+	uint32_t fraction = n - intPart * divisor;
+
+	// format intPart and decimal point
+	if (nd || (flags() & showpoint))
+	{
+		*--str = '.';
+	}
+	str = fmtNum (intPart, str, 10);
+
+	// format the fraction digits of the value
+	char * frac = end + scale;
+	for (char * ptr = frac; ptr > end; fraction /= 10)
+	{
+		*--ptr = fraction % 10 + '0';
+	}
+
+	// calculate length for fill
+	uint8_t len = sign ? 1 : 0;
+	len += nd + end - str;
+
+	// extract adjust field
+	fmtflags adj = flags() & adjustfield;
+	if (adj == internal)
+	{
+		if (sign)
+		{
+			putch (sign);
+		}
+		do_fill (len);
+	}
+	else
+	{
+		// do fill for internal or right
+		fill_not_left (len);
+		if (sign)
+		{
+			*--str = sign;
+		}
+	}
+	putstr (str, frac - str);
+	// the digits beyond the scale of the value are zeros
+	for (nd -= scale; nd > 0;)
+	{
+		uint8_t count = nd < 8 ? nd : 8;
+		putstr ("00000000", count);
+		nd -= count;
+	}
+	// do fill if not done above
+	do_fill (len);
+} // ostream::putFixed
 
 // ------------------------------------------------------------------------------
-void ostream::putNum (uint32_t n, bool neg)
+char * ostream::fmtSign (char * str, bool neg, uint8_t base)
 {
-	char buf[13];
-	char * end = buf + sizeof(buf) - 1;
-	char * num;
-	char * str;
-	uint8_t base = flagsToBase();
-
-	*end = '\0';
-	str  = num = fmtNum (n, end, base);
 	if (base == 10)
 	{
 		if (neg)
@@ -235,44 +379,322 @@ void ostream::putNum (uint32_t n, bool neg)
 		}
 		*--str = '0';
 	}
+	return str;
+}
+
+// ------------------------------------------------------------------------------
+void ostream::putNum (int32_t n)
+{
+	bool neg = n < 0 && flagsToBase() == 10;
+
+	if (neg)
+	{
+		n = -n;
+	}
+	putNum (n, neg);
+}
+
+// ------------------------------------------------------------------------------
+void ostream::putNum (uint32_t n, bool neg)
+{
+	char buf[2 + 32]; // room for "0b" and 32 binary digits
+	char * end = buf + sizeof(buf);
+	char * num;
+	char * str;
+	uint8_t base = flagsToBase();
+
+	num = fmtNum (n, end, base);
+	str = fmtSign (num, neg, base);
+
 	uint8_t len  = end - str;
 	fmtflags adj = flags() & adjustfield;
-	if (adj == internal)
+	if (adj == internal && str < num)
 	{
-		while (str < num)
-		{
-			putch (*str++);
-		}
+		putstr (str, num - str);
+		str = num;
 	}
 	if (adj != left)
 	{
 		do_fill (len);
 	}
-	putstr (str);
+	putstr (str, end - str);
 	do_fill (len);
 } // ostream::putNum
 
+// ------------------------------------------------------------------------------
+void ostream::putFill (unsigned count)
+{
+	char buf[AL_FILL_BUFFER_SIZE];
+	unsigned chunk = count < AL_FILL_BUFFER_SIZE ? count : AL_FILL_BUFFER_SIZE;
+
+	memset (buf, fill(), chunk);
+	while (count)
+	{
+		if (count < chunk)
+		{
+			chunk = count;
+		}
+		putstr (buf, chunk);
+		count -= chunk;
+	}
+}
+
 // ------------------------------------------------------------------------------
 void ostream::putPgm (const char * str)
 {
-	int n;
+	char buf[AL_PGM_BUFFER_SIZE];
+	unsigned n = strlen_P (str);
 
-	for (n = 0; pgm_read_byte (&str[n]); n++)
-	{ }
 	fill_not_left (n);
-	for (uint8_t c; (c = pgm_read_byte (str)); str++)
+	for (unsigned left = n; left;)
 	{
-		putch (c);
+		unsigned chunk = left < AL_PGM_BUFFER_SIZE ? left : AL_PGM_BUFFER_SIZE;
+
+		memcpy_P (buf, str, chunk);
+		putstr (buf, chunk);
+		str  += chunk;
+		left -= chunk;
 	}
 	do_fill (n);
 }
 
+// ------------------------------------------------------------------------------
+/** Print collecting an output in chunks, for the Printable objects and the spans */
+class ChunkWriter : public Print
+{
+public:
+	/** constructor
+	 * \param[in] os the stream
+	 * \param[in] hold keep the output in the buffer, only counting what does not fit
+	 */
+	ChunkWriter(ostream & os, bool hold) : os (os), hold (hold), used (0), total (0){ }
+
+	size_t write (uint8_t c)
+	{
+		return write (&c, 1);
+	}
+
+	size_t write (const uint8_t * buffer, size_t size)
+	{
+		for (size_t left = size; left;)
+		{
+			if (used == sizeof(buf))
+			{
+				if (hold)
+				{
+					total += left;
+					return size;
+				}
+				putBuffer();
+			}
+
+			size_t chunk = sizeof(buf) - used < left ? sizeof(buf) - used : left;
+
+			memcpy (buf + used, buffer, chunk);
+			used   += chunk;
+			total  += chunk;
+			buffer += chunk;
+			left   -= chunk;
+		}
+		return size;
+	}
+
+	/** add fill characters
+	 * \param[in] count number of characters
+	 */
+	void putFill (size_t count)
+	{
+		while (count)
+		{
+			if (used == sizeof(buf))
+			{
+				putBuffer();
+			}
+
+			size_t chunk = sizeof(buf) - used < count ? sizeof(buf) - used : count;
+
+			memset (buf + used, os.fill(), chunk);
+			used  += chunk;
+			total += chunk;
+			count -= chunk;
+		}
+	}
+
+	/** output the buffer content */
+	void putBuffer ()
+	{
+		os.putstr (buf, used);
+		used = 0;
+	}
+
+	using Print::write;
+
+	ostream & os;
+	bool hold;
+	size_t used;
+	size_t total;
+	char buf[AL_PGM_BUFFER_SIZE];
+};
+
+// ------------------------------------------------------------------------------
+void ostream::putPrintable (const Printable & arg)
+{
+	// The fill before the value needs its length: up to a buffer, the value is
+	// kept, a longer value is only counted and printed again
+	if (width() && (flags() & adjustfield) != left)
+	{
+		ChunkWriter counter (*this, true);
+
+		arg.printTo (counter);
+		fill_not_left (counter.total);
+
+		if (counter.total == counter.used)
+		{
+			counter.putBuffer();
+			return;
+		}
+	}
+
+	ChunkWriter writer (*this, false);
+
+	arg.printTo (writer);
+	writer.putBuffer();
+	do_fill (writer.total);
+}
+
+// ------------------------------------------------------------------------------
+void ostream::putSpan (const void * data, size_t count, uint8_t type, const char * separator)
+{
+	ChunkWriter writer (*this, false);
+	unsigned w      = width();
+	size_t sepLen   = strlen (separator);
+	uint8_t base    = flagsToBase();
+	fmtflags adj    = flags() & adjustfield;
+	uint8_t nd      = precision();
+	double round    = 0.5;
+	char buf[2 + 32 + 1]; // room for "0b", 32 binary digits and '.'
+	char * end = buf + sizeof(buf);
+
+	for (uint8_t i = 0; i < nd; ++i)
+	{
+		round *= 0.1;
+	}
+	width (0);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		char * num;
+		char * str;
+		uint8_t fraction = 0; // fraction digits following the number
+		double fractionPart = 0;
+
+		if (i)
+		{
+			writer.write ((const uint8_t *) separator, sepLen);
+		}
+
+		if (type == span::FLOAT || type == span::DOUBLE)
+		{
+			double n = type == span::FLOAT ? static_cast<const float *>(data)[i] :
+			  static_cast<const double *>(data)[i];
+			bool neg = n < 0.0;
+
+			if (neg)
+			{
+				n = -n;
+			}
+			if (n > 4.0E9)
+			{
+				writer.print (F ("BIG FLT"));
+				continue;
+			}
+			n += round;
+			uint32_t intPart = n;
+			fractionPart = n - intPart;
+			fraction     = nd;
+
+			num = end;
+			if (nd || (flags() & showpoint))
+			{
+				*--num = '.';
+			}
+			num = fmtNum (intPart, num, 10);
+			str = fmtSign (num, neg, 10);
+		}
+		else
+		{
+			uint32_t n;
+			bool neg = false;
+
+			switch (type)
+			{
+				case span::INT8:
+				case span::INT16:
+				case span::INT32:
+				{
+					int32_t v = type == span::INT8 ? static_cast<const int8_t *>(data)[i] :
+					  type == span::INT16 ? static_cast<const int16_t *>(data)[i] :
+					  static_cast<const int32_t *>(data)[i];
+					neg = v < 0 && base == 10;
+					n   = neg ? 0 - (uint32_t) v : (uint32_t) v;
+					break;
+				}
+
+				case span::UINT8:
+					n = static_cast<const uint8_t *>(data)[i];
+					break;
+
+				case span::UINT16:
+					n = static_cast<const uint16_t *>(data)[i];
+					break;
+
+				default:
+					n = static_cast<const uint32_t *>(data)[i];
+					break;
+			}
+
+			num = fmtNum (n, end, base);
+			str = fmtSign (num, neg, base);
+		}
+
+		// same adjustment as putNum and putDouble, for each element
+		unsigned len = end - str + fraction;
+		unsigned pad = len < w ? w - len : 0;
+		if (adj == internal)
+		{
+			writer.write ((const uint8_t *) str, num - str);
+			str = num;
+		}
+		if (adj != left)
+		{
+			writer.putFill (pad);
+		}
+		writer.write ((const uint8_t *) str, end - str);
+		for (; fraction > 0; fraction--)
+		{
+			fractionPart *= 10.0;
+			int digit = static_cast<int>(fractionPart);
+			writer.write ((uint8_t) (digit + '0'));
+			fractionPart -= digit;
+		}
+		if (adj == left)
+		{
+			writer.putFill (pad);
+		}
+	}
+	writer.putBuffer();
+} // ostream::putSpan
+
 // ------------------------------------------------------------------------------
 void ostream::putStr (const char * str)
 {
-	unsigned n = strlen (str);
+	putStr (str, strlen (str));
+}
 
-	fill_not_left (n);
-	putstr (str);
-	do_fill (n);
+// ------------------------------------------------------------------------------
+void ostream::putStr (const char * str, size_t len)
+{
+	fill_not_left (len);
+	putstr (str, len);
+	do_fill (len);
 }
\ No newline at end of file
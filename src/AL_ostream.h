@@ -34,8 +34,25 @@
  */
 #include "Arduino.h"
 #include <AL_ios.h>
+#include <AL_traits.h>
+
+/** Size of the stack buffer used to output padding characters in bulk */
+#ifndef AL_FILL_BUFFER_SIZE
+# define AL_FILL_BUFFER_SIZE 16
+#endif
+
+/** Size of the stack buffer used to copy flash strings before output */
+#ifndef AL_PGM_BUFFER_SIZE
+# define AL_PGM_BUFFER_SIZE 32
+#endif
 // ==============================================================================
 
+struct strview;
+struct bytes;
+struct hexdump;
+struct fixed;
+struct span;
+
 /**
  * \class ostream
  * \brief Output Stream
@@ -239,7 +256,18 @@ public:
 	 */
 	ostream &operator << (const String & arg)
 	{
-		putStr ((const char *) arg.c_str());
+		putStr (arg.c_str(), arg.length());
+		return *this;
+	}
+
+	/**
+	 * Output a printable object (IPAddress...), honoring width and fill
+	 * \param[in] arg the object to output
+	 * \return the stream
+	 */
+	ostream &operator << (const Printable & arg)
+	{
+		putPrintable (arg);
 		return *this;
 	}
 
@@ -258,7 +286,21 @@ public:
 		return *this;
 	}
 
-	//  ostream& write(char *str, streamsize count);
+	/**
+	 * Writes a block of characters to the stream.
+	 *
+	 * The unformatted output function inserts the \a count first characters
+	 * of \a str, which does not need to be null-terminated.
+	 *
+	 * \param[in] str The characters
+	 * \param[in] count The number of characters to write
+	 * \return A reference to the ostream object.
+	 */
+	ostream& write (const char * str, streamsize count)
+	{
+		putstr (str, count);
+		return *this;
+	}
 
 	/**
 	 * Flushes the buffer associated with this stream. The flush function
@@ -319,11 +361,16 @@ protected:
 	/** Put character with binary/text conversion
 	 * \param[in] ch character to write
 	 */
-	virtual void putch (char ch)                     = 0;
-	virtual void putstr (const char * str)           = 0;
-	virtual bool seekoff (off_type pos, seekdir way) = 0;
-	virtual bool seekpos (pos_type pos)              = 0;
-	virtual bool sync ()                             = 0;
+	virtual void putch (char ch) = 0;
+
+	/** Put a block of characters, not necessarily null-terminated
+	 * \param[in] str characters to write
+	 * \param[in] len number of characters to write
+	 */
+	virtual void putstr (const char * str, size_t len) = 0;
+	virtual bool seekoff (off_type pos, seekdir way)   = 0;
+	virtual bool seekpos (pos_type pos)                = 0;
+	virtual bool sync ()                               = 0;
 
 	virtual pos_type tellpos () = 0;
 	/// @endcond
@@ -331,13 +378,29 @@ private:
 	void do_fill (unsigned len);
 	void fill_not_left (unsigned len);
 	char * fmtNum (uint32_t n, char * ptr, uint8_t base);
+	char * fmtSign (char * str, bool neg, uint8_t base);
 	void putBool (bool b);
 	void putChar (char c);
 	void putDouble (double n);
+	void putFixed (int32_t value, uint8_t scale);
+	void putFill (unsigned count);
 	void putNum (uint32_t n, bool neg = false);
 	void putNum (int32_t n);
 	void putPgm (const char * str);
 	void putStr (const char * str);
+	void putStr (const char * str, size_t len);
+
+	void putBytes (const uint8_t * data, size_t len);
+	void putHexDump (const uint8_t * data, size_t len);
+	void putPrintable (const Printable & arg);
+	void putSpan (const void * data, size_t count, uint8_t type, const char * separator);
+
+	friend class ChunkWriter;
+	friend ostream &operator << (ostream &os, const strview &arg);
+	friend ostream &operator << (ostream &os, const bytes &arg);
+	friend ostream &operator << (ostream &os, const hexdump &arg);
+	friend ostream &operator << (ostream &os, const fixed &arg);
+	friend ostream &operator << (ostream &os, const span &arg);
 };
 
 // ------------------------------------------------------------------------------ Content originally from iostream.h
@@ -450,6 +513,206 @@ inline ostream &operator << (ostream &os, const setw &arg)
 	return os;
 }
 
+// ------------------------------------------------------------------------------
+
+/** \struct strview
+ * \brief Non-owning view on a block of characters that may not be
+ * null-terminated, such as a received packet or a slice of a larger buffer
+ */
+struct strview
+{
+	/** first character */
+	const char * str;
+	/** number of characters */
+	size_t len;
+
+	/** constructor
+	 * \param[in] s first character
+	 * \param[in] n number of characters
+	 */
+	strview(const char * s, size_t n) : str (s), len (n){ }
+};
+
+/** Output the characters of a view, honoring width and fill
+ * \param[in] os the stream
+ * \param[in] arg the view to output
+ * \return the stream
+ */
+inline ostream &operator << (ostream &os, const strview &arg)
+{
+	os.putStr (arg.str, arg.len);
+	return os;
+}
+
+// ------------------------------------------------------------------------------
+
+/** \struct bytes
+ * \brief type for bytes manipulator, outputs a buffer as space separated
+ * hexadecimal bytes ("0A 1B 2C")
+ */
+struct bytes
+{
+	/** first byte */
+	const uint8_t * data;
+	/** number of bytes */
+	size_t len;
+
+	/** constructor
+	 * \param[in] d first byte
+	 * \param[in] n number of bytes
+	 */
+	bytes(const void * d, size_t n) : data (static_cast<const uint8_t *>(d)), len (n){ }
+};
+
+/** bytes manipulator
+ * \param[in] os the stream
+ * \param[in] arg the buffer to output
+ * \return the stream
+ */
+inline ostream &operator << (ostream &os, const bytes &arg)
+{
+	os.putBytes (arg.data, arg.len);
+	return os;
+}
+
+// ------------------------------------------------------------------------------
+
+/** \struct hexdump
+ * \brief type for hexdump manipulator, outputs a buffer as rows of 16 bytes
+ * with the offset, the hexadecimal values and the ASCII characters.
+ * Rows are separated by a new line, the last one is not terminated.
+ */
+struct hexdump
+{
+	/** first byte */
+	const uint8_t * data;
+	/** number of bytes */
+	size_t len;
+
+	/** constructor
+	 * \param[in] d first byte
+	 * \param[in] n number of bytes
+	 */
+	hexdump(const void * d, size_t n) : data (static_cast<const uint8_t *>(d)), len (n){ }
+};
+
+/** hexdump manipulator
+ * \param[in] os the stream
+ * \param[in] arg the buffer to output
+ * \return the stream
+ */
+inline ostream &operator << (ostream &os, const hexdump &arg)
+{
+	os.putHexDump (arg.data, arg.len);
+	return os;
+}
+
+// ------------------------------------------------------------------------------
+
+/** \struct fixed
+ * \brief Scaled integer output as a decimal number (value / 10^scale),
+ * formatted with integer operations only. The output is the same as the
+ * output of the equivalent double: precision, width, fill and showpos apply.
+ */
+struct fixed
+{
+	/** scaled value */
+	int32_t value;
+	/** number of decimal digits of the value, up to 9 */
+	uint8_t scale;
+
+	/** constructor
+	 * \param[in] v scaled value, e.g. 2315 for 23.15
+	 * \param[in] s number of decimal digits of the value, e.g. 2 for 23.15
+	 */
+	fixed(int32_t v, uint8_t s) : value (v), scale (s){ }
+};
+
+/** Scaled integer with a number of decimal digits known at compile time
+ * \param[in] value scaled value, e.g. decimal<2> (2315) for 23.15
+ * \return the fixed value
+ */
+template <uint8_t Scale>
+inline fixed decimal (int32_t value)
+{
+	static_assert (Scale <= 9, "decimal: the scale of a 32 bits value is at most 9");
+	return fixed (value, Scale);
+}
+
+/** fixed output
+ * \param[in] os the stream
+ * \param[in] arg the scaled value to output
+ * \return the stream
+ */
+inline ostream &operator << (ostream &os, const fixed &arg)
+{
+	os.putFixed (arg.value, arg.scale);
+	return os;
+}
+
+// ------------------------------------------------------------------------------
+
+/** \struct span
+ * \brief Array of numbers output as a list, e.g. span (samples, 16) or
+ * span (samples, 16, " ") for "12, 15, 13..." or "12 15 13...".
+ * The elements follow the base, precision, fill and flags of the stream,
+ * the width applies to each element. The array is formatted in chunks.
+ */
+struct span
+{
+	/** element types */
+	enum Type { INT8, UINT8, INT16, UINT16, INT32, UINT32, FLOAT, DOUBLE };
+
+	/** first element */
+	const void * data;
+	/** number of elements */
+	size_t count;
+	/** text between the elements */
+	const char * separator;
+	/** element type */
+	uint8_t type;
+
+	/** constructor
+	 * \param[in] d first element, of an integer type up to 32 bits (bool is output as 0 or 1) or a floating point type
+	 * \param[in] n number of elements
+	 * \param[in] sep text between the elements
+	 */
+	template <class T>
+	span(const T * d, size_t n, const char * sep = ", ") :
+		data (d), count (n), separator (sep),
+		type (typeOf (al_traits::Number<T>::size, al_traits::Number<T>::isSigned, al_traits::Number<T>::isFloat))
+	{
+		static_assert (!al_traits::Number<T>::isInt64, "span: 64 bits integers are not supported");
+	}
+
+	/** constructor
+	 * \param[in] a array
+	 * \param[in] sep text between the elements
+	 */
+	template <class T, size_t N>
+	span(const T (&a)[N], const char * sep = ", ") : span (&a[0], N, sep){ }
+
+private:
+	static constexpr uint8_t typeOf (size_t size, bool isSigned, bool isFloat)
+	{
+		return isFloat ? (size == sizeof(float) ? FLOAT : DOUBLE) :
+		       size == 1 ? (isSigned ? INT8 : UINT8) :
+		       size == 2 ? (isSigned ? INT16 : UINT16) :
+		       (isSigned ? INT32 : UINT32);
+	}
+};
+
+/** span output
+ * \param[in] os the stream
+ * \param[in] arg the array to output
+ * \return the stream
+ */
+inline ostream &operator << (ostream &os, const span &arg)
+{
+	os.putSpan (arg.data, arg.count, arg.type, arg.separator);
+	return os;
+}
+
 // ==============================================================================
 
 #endif // ostream_h
\ No newline at end of file
@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "AL_print.h"
+
+size_t LogPrint::write (uint8_t c)
+{
+	return write (&c, 1);
+}
+
+size_t LogPrint::write (const uint8_t * buffer, size_t size)
+{
+	const char * str = (const char *) buffer;
+	const char * end = str + size;
+
+	if (_pendingCr && size)
+	{
+		_pendingCr = false;
+		if (*str != '\n')
+			_logger.put ('\r');
+	}
+
+	while (str < end)
+	{
+		const char * eol = (const char *) memchr (str, '\n', end - str);
+		const char * last = eol ? eol : end;
+
+		// The '\r' of a "\r\n" is dropped, even split over two writes: endl ends the line
+		if (last > str && last[-1] == '\r')
+		{
+			last--;
+			_pendingCr = !eol;
+		}
+
+		if (last > str)
+			_logger.write (str, last - str);
+
+		if (!eol)
+			break;
+
+		_logger << endl;
+		str = eol + 1;
+	}
+
+	return size;
+}
@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_PRINT_H
+#define AL_PRINT_H
+
+#include <ArduinoLogger.h>
+
+/**
+ * Print interface of a logger, to route the debug output of other libraries through the logger:
+ *
+ * LogPrint gpsLog (trace);
+ * gps.setDebugOutput (gpsLog);
+ *
+ * The text is passed to the logger in blocks, each '\n' ends a line of the logger (the '\r' of a "\r\n" is dropped,
+ * another '\r' is kept)
+ */
+class LogPrint : public Print
+{
+public:
+	explicit LogPrint(ArduinoLogger & logger) : _logger (logger), _pendingCr (false){ }
+
+	size_t write (uint8_t c);
+	size_t write (const uint8_t * buffer, size_t size);
+	using Print::write;
+
+private:
+	ArduinoLogger & _logger;
+	bool _pendingCr; // The previous block ended with a '\r', written unless a '\n' follows
+};
+
+#endif // ifndef AL_PRINT_H
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "ArduinoLogger.h"
+
+// Counter measuring the cost of the log statements
+#ifndef AL_PROFILE_COUNTER
+# if defined(ESP8266) || defined(ESP32)
+#  define AL_PROFILE_COUNTER() ESP.getCycleCount()
+#  define AL_PROFILE_UNIT      "cycles"
+# else
+#  define AL_PROFILE_COUNTER() micros()
+#  define AL_PROFILE_UNIT      "us"
+# endif
+#endif
+
+static LogSite * sites = NULL; // Visited sites, most recent first
+
+LogSiteScope::LogSiteScope (LogSite & site, ArduinoLogger & logger) : _site (site), _logger (logger)
+{
+	if (!site.linked)
+	{
+		site.next   = sites;
+		site.linked = true;
+		sites       = &site;
+	}
+
+	site.hits++;
+	if (!logger.isActive())
+		site.suppressed++;
+
+	_start = AL_PROFILE_COUNTER();
+}
+
+LogSiteScope::~LogSiteScope ()
+{
+	uint32_t cost = _site.cost + (uint32_t) (AL_PROFILE_COUNTER() - _start);
+
+	_site.cost = cost < _site.cost ? 0xFFFFFFFF : cost;
+}
+
+void ArduinoLogger::dumpProfile (uint8_t count) const
+{
+	ArduinoLogger out (LOG_LEVEL_INFO, *_registry);
+	LogSite * previous = NULL;
+
+	// Selection of the costliest sites, in decreasing order, without sorting the list
+	for (uint8_t n = 0; n < count; n++)
+	{
+		LogSite * worst = NULL;
+
+		for (LogSite * site = sites; site != NULL; site = site->next)
+		{
+			if (!site->hits)
+				continue;
+
+			// Below the previous one, the ties being ordered by address
+			if (previous != NULL && (site->cost > previous->cost ||
+			  (site->cost == previous->cost && site >= previous)))
+				continue;
+
+			if (worst == NULL || site->cost > worst->cost || (site->cost == worst->cost && site > worst))
+				worst = site;
+		}
+
+		if (worst == NULL)
+			break;
+
+		const char * file = strrchr (worst->file, '/');
+
+		out << (file ? file + 1 : worst->file) << ':' << worst->line
+		    << F (" hits=") << worst->hits
+		    << F (" suppressed=") << worst->suppressed
+		    << F (" cost=") << worst->cost
+		    << F (" avg=") << worst->cost / worst->hits << F (" " AL_PROFILE_UNIT) << endl;
+
+		previous = worst;
+	}
+} // ArduinoLogger::dumpProfile
+
+void ArduinoLogger::clearProfile () const
+{
+	for (LogSite * site = sites; site != NULL; site = site->next)
+	{
+		site->hits       = 0;
+		site->suppressed = 0;
+		site->cost       = 0;
+	}
+}
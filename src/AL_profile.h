@@ -0,0 +1,73 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_PROFILE_H
+#define AL_PROFILE_H
+
+#include <Arduino.h>
+
+class ArduinoLogger;
+
+// Statistics of a profiled log statement
+struct LogSite
+{
+	const char * file;
+	uint16_t line;
+	bool     linked;     // In the list of the visited sites
+	uint32_t hits;       // Number of executions
+	uint32_t suppressed; // Executions output nowhere
+	uint32_t cost;       // Time spent formatting and writing (AL_PROFILE_UNIT), saturates
+	LogSite * next;
+};
+
+// Measures a log statement, from its construction to the end of the full expression
+class LogSiteScope
+{
+public:
+	LogSiteScope(LogSite & site, ArduinoLogger & logger);
+	~LogSiteScope();
+
+	ArduinoLogger & logger (){ return _logger; }
+
+private:
+	LogSite & _site;
+	ArduinoLogger & _logger;
+	uint32_t _start;
+};
+
+// Profiled log statement, when AL_PROFILE is defined before including the library:
+// LOG_SITE (inf) << "rpm=" << rpm << endl;
+// Without AL_PROFILE, LOG_SITE (inf) is inf and costs nothing
+#ifdef AL_PROFILE
+# define LOG_SITE(target) \
+	LogSiteScope ([] () -> LogSite & { \
+		static LogSite site = { __FILE__, __LINE__, false, 0, 0, 0, NULL }; \
+		return site; \
+	} (), target).logger()
+#else
+# define LOG_SITE(target) (target)
+#endif
+
+#endif // ifndef AL_PROFILE_H
@@ -0,0 +1,197 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "AL_queue.h"
+
+size_t LogLane::append (const uint8_t * data, size_t len)
+{
+	if (len > size - used)
+		len = size - used;
+
+	size_t head  = tail + used < size ? tail + used : tail + used - size;
+	size_t chunk = len < size - head ? len : size - head;
+
+	memcpy (buffer + head, data, chunk);
+	memcpy (buffer, data + chunk, len - chunk);
+	used += len;
+
+	return len;
+}
+
+size_t LogLane::drain (Print & target, size_t max)
+{
+	size_t written = 0;
+
+	while (committed && written < max)
+	{
+		size_t chunk = committed < size - tail ? committed : size - tail;
+
+		if (chunk > max - written)
+			chunk = max - written;
+
+		chunk = target.write (buffer + tail, chunk);
+		if (!chunk)
+			break;
+
+		tail       = tail + chunk < size ? tail + chunk : tail + chunk - size;
+		committed -= chunk;
+		used      -= chunk;
+		written   += chunk;
+	}
+
+	return written;
+}
+
+QueuedSink::QueuedSink (Print & target, uint8_t * buffer, size_t size, size_t reserved) :
+	_target (target), _lane (&_low), _priorityLevel (LOG_LEVEL_WARNING), _syncLevel (LOG_LEVEL_SILENT),
+	_sync (false), _inLine (false), _droppedLine (false), _direct (false), _dropped (0)
+{
+	if (reserved > size)
+		reserved = size;
+
+	_high.buffer    = buffer;
+	_high.size      = reserved;
+	_high.tail      = 0;
+	_high.committed = 0;
+	_high.used      = 0;
+
+	_low.buffer    = buffer + reserved;
+	_low.size      = size - reserved;
+	_low.tail      = 0;
+	_low.committed = 0;
+	_low.used      = 0;
+}
+
+void QueuedSink::setPriorityLevel (uint8_t level)
+{
+	_priorityLevel = level;
+}
+
+void QueuedSink::setSyncLevel (uint8_t level)
+{
+	_syncLevel = level;
+}
+
+size_t QueuedSink::drain (size_t max)
+{
+	size_t written = _high.drain (_target, max);
+
+	// The other lines only once the important ones are written
+	if (!_high.committed)
+		written += _low.drain (_target, max - written);
+
+	return written;
+}
+
+void QueuedSink::flush ()
+{
+	drain();
+}
+
+size_t QueuedSink::pending () const
+{
+	return _high.committed + _low.committed;
+}
+
+size_t QueuedSink::queued () const
+{
+	return _high.used + _low.used;
+}
+
+uint16_t QueuedSink::dropped () const
+{
+	return _dropped;
+}
+
+void QueuedSink::beginLine (uint8_t level)
+{
+	_lane        = level <= _priorityLevel ? &_high : &_low;
+	_sync        = level <= _syncLevel;
+	_inLine      = true;
+	_droppedLine = false;
+	_direct      = false;
+}
+
+void QueuedSink::endLine ()
+{
+	if (!_droppedLine)
+		_lane->committed = _lane->used;
+
+	if (_sync)
+	{
+		_high.drain (_target, (size_t) -1);
+		if (_lane == &_low)
+			_low.drain (_target, (size_t) -1);
+	}
+
+	_lane   = &_low;
+	_sync   = false;
+	_inLine = false;
+	_direct = false;
+}
+
+size_t QueuedSink::write (uint8_t c)
+{
+	return write (&c, 1);
+}
+
+size_t QueuedSink::write (const uint8_t * buffer, size_t size)
+{
+	if (_droppedLine)
+		return size;
+
+	if (_direct)
+		return _target.write (buffer, size);
+
+	size_t n = _lane->append (buffer, size);
+
+	if (n < size)
+	{
+		if (_lane == &_high)
+		{
+			// The important lines are written at once rather than dropped
+			_high.committed = _high.used;
+			_high.drain (_target, (size_t) -1);
+			_target.write (buffer + n, size - n);
+			_direct = _inLine;
+		}
+		else
+		{
+			// The incomplete line is removed
+			_low.used    = _low.committed;
+			_droppedLine = true;
+			_dropped++;
+		}
+	}
+
+	// Outside of a line, each block is complete
+	if (!_inLine)
+	{
+		_lane->committed = _lane->used;
+		_droppedLine     = false;
+	}
+
+	return size;
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_QUEUE_H
+#define AL_QUEUE_H
+
+#include <ArduinoLogger.h>
+
+// Ring buffer of the lines of one priority, a line is readable once complete
+struct LogLane
+{
+	uint8_t * buffer;
+	size_t size;
+	size_t tail;      // Oldest character
+	size_t committed; // Characters of the complete lines
+	size_t used;      // Characters of the complete lines and of the current one
+
+	size_t append (const uint8_t * data, size_t len); // Returns the number of characters that fit
+	size_t drain (Print & target, size_t max);        // Writes up to max characters of the complete lines
+};
+
+/**
+ * Output queueing the lines for a slower target, with a lane reserved to the important lines:
+ *
+ * uint8_t queueBuffer[1024];
+ * QueuedSink queue (Serial, queueBuffer, sizeof(queueBuffer), 256);
+ *
+ * logger.add (queue, LOG_LEVEL_VERBOSE);
+ * queue.drain (Serial.availableForWrite ()); // In loop (), or logger.service (budget) for all the queues
+ *
+ * The lines of the priority level and below go to the reserved part of the buffer and are written first.
+ * When the other part is full, the new lines of the other levels are dropped; when the reserved part is full,
+ * it is written to the target at once, so the important lines are never dropped: the logging call then blocks
+ * on a synchronous write, like a sync level line.
+ * The lines of the sync level and below are written to the target when they end, after the queued
+ * important lines.
+ * The flight recorder context dumped before a line is part of that line: it goes to the same lane, ahead of it.
+ */
+class QueuedSink : public LogSink
+{
+public:
+	QueuedSink(Print & target, uint8_t * buffer, size_t size, size_t reserved);
+
+	void setPriorityLevel (uint8_t level); // Default is LOG_LEVEL_WARNING
+	void setSyncLevel (uint8_t level);     // Default is LOG_LEVEL_SILENT: no synchronous line
+
+	size_t drain (size_t max = (size_t) -1); // Writes up to max queued characters, important lines first
+	void flush ();                            // Writes all the complete queued lines
+
+	size_t pending () const;   // Number of characters of the complete queued lines
+	size_t queued () const;    // Number of queued characters
+	uint16_t dropped () const; // Number of lines dropped since the beginning
+
+	void beginLine (uint8_t level);
+	void endLine ();
+
+	size_t write (uint8_t c);
+	size_t write (const uint8_t * buffer, size_t size);
+	using Print::write;
+
+private:
+	Print & _target;
+	LogLane _high; // Lines of the priority level and below
+	LogLane _low;  // Lines of the other levels
+	LogLane * _lane;
+	uint8_t _priorityLevel;
+	uint8_t _syncLevel;
+	bool _sync;        // The current line is written when it ends
+	bool _inLine;      // Between beginLine and endLine
+	bool _droppedLine; // The current line did not fit
+	bool _direct;      // The current line overflowed the reserved lane: its end is written to the target
+	uint16_t _dropped;
+};
+
+#endif // ifndef AL_QUEUE_H
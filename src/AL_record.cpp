@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "AL_record.h"
+
+void RecordBuffer::append (const void * data, size_t len)
+{
+	putstr ((const char *) data, len);
+}
+
+void RecordBuffer::putch (char c)
+{
+	putstr (&c, 1);
+}
+
+void RecordBuffer::putstr (const char * str, size_t len)
+{
+	// A CSV row too long for the buffer is truncated, a binary row always fits (checked by RecordLogger)
+	if (len > sizeof(data) - length)
+		len = sizeof(data) - length;
+
+	memcpy (data + length, str, len);
+	length += len;
+}
+
+bool RecordBuffer::seekoff (off_type off, seekdir way)
+{
+	(void) off;
+	(void) way;
+	return false;
+}
+
+bool RecordBuffer::seekpos (pos_type pos)
+{
+	(void) pos;
+	return false;
+}
+
+bool RecordBuffer::sync ()
+{
+	return true;
+}
+
+RecordBuffer::pos_type RecordBuffer::tellpos ()
+{
+	return length;
+}
+
+RecordWriter::RecordWriter (ArduinoLogger & logger, uint8_t format, const char * const * names, const uint8_t * types,
+  uint8_t nColumns) :
+	_logger (logger), _names (names), _types (types), _nColumns (nColumns), _format (format), _precision (3)
+{ }
+
+void RecordWriter::setPrecision (uint8_t precision)
+{
+	_precision = precision;
+}
+
+void RecordWriter::begin ()
+{
+	_row.length = 0;
+
+	if (_format == RECORD_BINARY)
+	{
+		_row.append (RECORD_MAGIC, 4);
+		_row << (char) RECORD_VERSION << (char) _nColumns;
+		for (uint8_t i = 0; i < _nColumns; i++)
+		{
+			_row << (char) _types[i];
+			_row.append (_names[i], strlen (_names[i]) + 1);
+		}
+	}
+	else
+	{
+		for (uint8_t i = 0; i < _nColumns; i++)
+		{
+			if (i)
+				_row << ',';
+			_row << _names[i];
+		}
+		_row << '\n';
+	}
+
+	write();
+}
+
+bool RecordWriter::beginRow ()
+{
+	if (!_logger.isActive())
+		return false;
+
+	_row.length = 0;
+
+	if (_format == RECORD_BINARY)
+		_row << (char) RECORD_SYNC;
+
+	return true;
+}
+
+void RecordWriter::add (int32_t value, uint8_t type)
+{
+	if (_format == RECORD_BINARY)
+	{
+		add ((uint32_t) value, type);
+		return;
+	}
+
+	if (_row.length)
+		_row << ',';
+	_row << value;
+}
+
+void RecordWriter::add (uint32_t value, uint8_t type)
+{
+	if (_format == RECORD_BINARY)
+	{
+		uint8_t size = type >= RECORD_INT32 ? 4 : type >= RECORD_INT16 ? 2 : 1;
+		uint8_t bytes[4];
+
+		for (uint8_t i = 0; i < size; i++)
+		{
+			bytes[i] = value;
+			value  >>= 8;
+		}
+
+		_row.append (bytes, size);
+		return;
+	}
+
+	if (_row.length)
+		_row << ',';
+	_row << value;
+}
+
+void RecordWriter::add (double value, uint8_t type)
+{
+	if (_format == RECORD_BINARY)
+	{
+		// IEEE 754 little-endian on all the supported platforms
+		if (type == RECORD_FLOAT32)
+		{
+			float f = value;
+			_row.append (&f, sizeof(f));
+		}
+		else
+		{
+			_row.append (&value, sizeof(value));
+		}
+		return;
+	}
+
+	if (_row.length)
+		_row << ',';
+	_row << setprecision (_precision) << value;
+}
+
+void RecordWriter::endRow ()
+{
+	if (_format == RECORD_CSV)
+		_row << '\n';
+
+	write();
+}
+
+void RecordWriter::write ()
+{
+	char fill = _logger.fill(); // Changed by np
+
+	_logger << np;
+	_logger.write (_row.data, _row.length);
+	_logger << eor;
+	_logger.fill (fill);
+}
@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_RECORD_H
+#define AL_RECORD_H
+
+#include <ArduinoLogger.h>
+#include <AL_traits.h>
+
+// Maximum size of a row
+#ifndef AL_RECORD_BUFFER_SIZE
+# define AL_RECORD_BUFFER_SIZE 128
+#endif
+
+#define RECORD_CSV    0 // One text line per row, values separated by commas
+#define RECORD_BINARY 1 // Packed little-endian rows, see extras/tools/record2csv.py
+
+// Column types of the binary format
+#define RECORD_INT8    1
+#define RECORD_UINT8   2
+#define RECORD_INT16   3
+#define RECORD_UINT16  4
+#define RECORD_INT32   5
+#define RECORD_UINT32  6
+#define RECORD_FLOAT32 7
+#define RECORD_FLOAT64 8
+
+#define RECORD_MAGIC   "ALRB" // Start of the binary header
+#define RECORD_VERSION 1
+#define RECORD_SYNC    0xA5 // First byte of each binary row
+
+// Column type of a value type, a bool is a RECORD_UINT8 column
+template <class T>
+struct RecordColumn
+{
+	typedef al_traits::Number<T> N;
+
+	static constexpr uint8_t type = N::isFloat ? (N::size == 4 ? RECORD_FLOAT32 : RECORD_FLOAT64) :
+	  N::size == 1 ? (N::isSigned ? RECORD_INT8 : RECORD_UINT8) :
+	  N::size == 2 ? (N::isSigned ? RECORD_INT16 : RECORD_UINT16) :
+	  (N::isSigned ? RECORD_INT32 : RECORD_UINT32);
+
+	static_assert (!N::isInt64, "RecordLogger: 64 bits integers are not supported");
+};
+
+// Type holding the values of a column type while a row is built
+template <uint8_t Type>
+struct RecordValue { typedef int32_t type; };
+template <>
+struct RecordValue<RECORD_UINT8> { typedef uint32_t type; };
+template <>
+struct RecordValue<RECORD_UINT16> { typedef uint32_t type; };
+template <>
+struct RecordValue<RECORD_UINT32> { typedef uint32_t type; };
+template <>
+struct RecordValue<RECORD_FLOAT32> { typedef double type; };
+template <>
+struct RecordValue<RECORD_FLOAT64> { typedef double type; };
+
+// Size of the binary row of the columns, RECORD_SYNC included
+template <class ... Columns>
+struct RecordRowSize { static constexpr size_t value = 1; };
+template <class T, class ... Columns>
+struct RecordRowSize<T, Columns ...>
+{
+	static constexpr size_t value = (RecordColumn<T>::type == RECORD_FLOAT64 ? 8 : RecordColumn<T>::type >= RECORD_INT32 ? 4 :
+	  RecordColumn<T>::type >= RECORD_INT16 ? 2 : 1) + RecordRowSize<Columns ...>::value;
+};
+
+// Row being built, formatted with the ostream insertions
+class RecordBuffer : public ostream
+{
+public:
+	RecordBuffer() : length (0){ }
+
+	void append (const void * data, size_t len);
+
+	size_t length;
+	char data[AL_RECORD_BUFFER_SIZE];
+
+private:
+	void putch (char c);
+	void putstr (const char * str, size_t len);
+	bool seekoff (off_type off, seekdir way);
+	bool seekpos (pos_type pos);
+	bool sync ();
+	pos_type tellpos ();
+};
+
+// Schema independent part of RecordLogger
+class RecordWriter
+{
+public:
+	void begin ();                         // Writes the CSV header line or the binary header
+	void setPrecision (uint8_t precision); // Number of decimals of the floating point CSV columns, 3 by default
+
+protected:
+	RecordWriter(ArduinoLogger & logger, uint8_t format, const char * const * names, const uint8_t * types, uint8_t nColumns);
+
+	bool beginRow (); // false if no output receives the level of the logger
+	void add (int32_t value, uint8_t type);
+	void add (uint32_t value, uint8_t type);
+	void add (double value, uint8_t type);
+	void endRow ();
+
+private:
+	void write ();
+
+	ArduinoLogger & _logger;
+	const char * const * _names;
+	const uint8_t * _types;
+	uint8_t _nColumns;
+	uint8_t _format;
+	uint8_t _precision;
+	RecordBuffer _row;
+};
+
+/**
+ * Fixed schema data logging, through the outputs and the level filtering of a logger:
+ *
+ * static const char * const columns[] = { "time", "ch0", "temp" };
+ * RecordLogger<uint32_t, int16_t, float> rec (data.inf, columns, RECORD_CSV);
+ *
+ * rec.begin ();                         // time,ch0,temp
+ * rec.record (millis (), adc, temp);    // 1234,512,21.500
+ *
+ * The rows are written without prefix, at the level of the logger. A binary row is a RECORD_SYNC byte followed
+ * by the values in little-endian order. The binary header is RECORD_MAGIC, RECORD_VERSION, the number of
+ * columns and the type and the null-terminated name of each column.
+ */
+template <class ... Columns>
+class RecordLogger : public RecordWriter
+{
+	static_assert (RecordRowSize<Columns ...>::value <= AL_RECORD_BUFFER_SIZE,
+	  "RecordLogger: the binary row does not fit AL_RECORD_BUFFER_SIZE");
+
+public:
+	RecordLogger(ArduinoLogger & logger, const char * const (&names)[sizeof ... (Columns)], uint8_t format = RECORD_CSV) :
+		RecordWriter (logger, format, names, types, sizeof ... (Columns))
+	{ }
+
+	template <class ... Args>
+	void record (Args ... values)
+	{
+		static_assert (sizeof ... (Args) == sizeof ... (Columns), "RecordLogger: wrong number of values");
+
+		if (!beginRow())
+			return;
+
+		int unused[] = {
+			(add ((typename RecordValue<RecordColumn<Columns>::type>::type) (Columns) values, RecordColumn<Columns>::type), 0) ...
+		};
+
+		(void) unused;
+		endRow();
+	}
+
+private:
+	static const uint8_t types[sizeof ... (Columns)];
+};
+
+template <class ... Columns>
+const uint8_t RecordLogger<Columns ...>::types[sizeof ... (Columns)] = { RecordColumn<Columns>::type ... };
+
+#endif // ifndef AL_RECORD_H
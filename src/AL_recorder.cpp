@@ -0,0 +1,93 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "AL_recorder.h"
+
+FlightRecorder::FlightRecorder (uint8_t * buffer, size_t size) :
+	_buffer (buffer), _size (size), _tail (0), _used (0)
+{ }
+
+void FlightRecorder::clear ()
+{
+	_tail = 0;
+	_used = 0;
+}
+
+size_t FlightRecorder::dump (Print & output)
+{
+	if (_tail + _used <= _size)
+		return output.write (_buffer + _tail, _used);
+
+	return output.write (_buffer + _tail, _size - _tail) + output.write (_buffer, _used - (_size - _tail));
+}
+
+size_t FlightRecorder::recorded () const
+{
+	return _used;
+}
+
+size_t FlightRecorder::write (uint8_t c)
+{
+	return write (&c, 1);
+}
+
+size_t FlightRecorder::write (const uint8_t * buffer, size_t size)
+{
+	size_t written = size;
+
+	// Only the end of a block bigger than the buffer would be kept
+	if (size > _size)
+	{
+		buffer += size - _size;
+		size    = _size;
+		clear();
+	}
+
+	while (_size - _used < size)
+		dropOldestLine();
+
+	size_t head  = _tail + _used < _size ? _tail + _used : _tail + _used - _size;
+	size_t chunk = size < _size - head ? size : _size - head;
+
+	memcpy (_buffer + head, buffer, chunk);
+	memcpy (_buffer, buffer + chunk, size - chunk);
+	_used += size;
+
+	return written;
+}
+
+void FlightRecorder::dropOldestLine ()
+{
+	while (_used)
+	{
+		uint8_t c = _buffer[_tail];
+
+		_tail = _tail + 1 < _size ? _tail + 1 : 0;
+		_used--;
+
+		if (c == '\n')
+			return;
+	}
+}
@@ -0,0 +1,55 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_RECORDER_H
+#define AL_RECORDER_H
+
+#include <Arduino.h>
+
+// Keeps the last lines written in a ring buffer, the oldest lines are dropped when it is full
+class FlightRecorder : public Print
+{
+public:
+	FlightRecorder(uint8_t * buffer, size_t size);
+
+	void clear ();                // Forgets the recorded lines
+	size_t dump (Print & output); // Writes the recorded lines, oldest first
+
+	size_t recorded () const; // Number of characters recorded
+
+	size_t write (uint8_t c);
+	size_t write (const uint8_t * buffer, size_t size);
+	using Print::write;
+
+private:
+	void dropOldestLine ();
+
+	uint8_t * _buffer;
+	size_t _size;
+	size_t _tail; // Oldest character
+	size_t _used;
+};
+
+#endif // ifndef AL_RECORDER_H
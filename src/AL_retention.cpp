@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "AL_retention.h"
+
+#define RETENTION_MAGIC 0x414C5254UL // "ALRT"
+
+RetentionSink::RetentionSink (void * region, size_t size) :
+	_header(),
+	_region ((uint8_t *) region),
+	_data ((uint8_t *) region + sizeof(Header)),
+	_size (size <= sizeof(Header) ? 0 : size - sizeof(Header) > 0xFFFF ? 0xFFFF : size - sizeof(Header))
+{ }
+
+bool RetentionSink::begin ()
+{
+	readHeader();
+
+	if (_header.magic == RETENTION_MAGIC && _header.size == _size && _header.head < _size &&
+	  _header.used <= _size && _header.check == checksum())
+		return _header.used > 0;
+
+	_header.magic = RETENTION_MAGIC;
+	_header.size  = _size;
+	clear();
+
+	return false;
+}
+
+void RetentionSink::clear ()
+{
+	_header.head  = 0;
+	_header.used  = 0;
+	writeHeader();
+}
+
+size_t RetentionSink::retained () const
+{
+	return _header.used;
+}
+
+size_t RetentionSink::replay (Print & output)
+{
+	uint16_t used  = _header.used;
+	uint16_t start = _header.head >= used ? _header.head - used : _header.head + _size - used;
+
+	// A full buffer starts with a partly overwritten line: the output starts with the next complete one
+	if (used == _size)
+	{
+		uint16_t skip = 0;
+
+		while (skip < used && _data[start + skip < _size ? start + skip : start + skip - _size] != '\n')
+			skip++;
+
+		if (skip < used)
+		{
+			start = start + skip + 1 < _size ? start + skip + 1 : start + skip + 1 - _size;
+			used -= skip + 1;
+		}
+	}
+
+	if (start + used <= _size)
+		return output.write (_data + start, used);
+
+	return output.write (_data + start, _size - start) + output.write (_data, used - (_size - start));
+}
+
+size_t RetentionSink::write (uint8_t c)
+{
+	return write (&c, 1);
+}
+
+size_t RetentionSink::write (const uint8_t * buffer, size_t size)
+{
+	size_t written = size;
+
+	if (!_size)
+		return 0;
+
+	// Only the end of a block bigger than the buffer would be kept
+	if (size > _size)
+	{
+		buffer += size - _size;
+		size    = _size;
+	}
+
+	uint16_t head  = _header.head;
+	uint16_t chunk = size < (size_t) (_size - head) ? size : _size - head;
+
+	memcpy (_data + head, buffer, chunk);
+	memcpy (_data, buffer + chunk, size - chunk);
+
+	head += size;
+	if (head >= _size)
+		head -= _size;
+
+	_header.head = head;
+	_header.used = _header.used + size < _size ? _header.used + size : _size;
+	writeHeader();
+
+	return written;
+}
+
+void RetentionSink::readHeader ()
+{
+	memcpy (&_header, _region, sizeof(Header));
+}
+
+void RetentionSink::writeHeader ()
+{
+	_header.check = checksum();
+	memcpy (_region, &_header, sizeof(Header));
+}
+
+uint16_t RetentionSink::checksum () const
+{
+	return (uint16_t) (_header.magic ^ (_header.magic >> 16) ^ _header.size ^ _header.head ^ _header.used ^ 0x5A5A);
+}
@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_RETENTION_H
+#define AL_RETENTION_H
+
+#include <Arduino.h>
+
+// Places a buffer in memory that is not cleared by a reset, to be given to a RetentionSink
+// e.g. AL_RETAINED uint8_t retained[512];
+#ifndef AL_RETAINED
+# if defined(ESP32)
+#  define AL_RETAINED RTC_NOINIT_ATTR
+# elif defined(__unix__) || defined(__APPLE__)
+#  define AL_RETAINED // Host builds can give a memory mapped file to simulate the retention
+# else
+#  define AL_RETAINED __attribute__ ((section (".noinit")))
+# endif
+#endif
+
+// Output keeping the last written characters in a buffer that survives a reset
+// The region needs no alignment, the header is copied in and out of it
+// A write is a plain copy followed by the header update, the checksum only covers the header: after a reset
+// during a write, the header still describes the previous content, whose oldest line may have been
+// partly overwritten, replay () skips it
+class RetentionSink : public Print
+{
+public:
+	RetentionSink(void * region, size_t size);
+
+	bool begin (); // Returns true if content from before the reset was found, which is kept until cleared or overwritten
+	void clear (); // Forgets the retained content
+
+	size_t retained () const;      // Number of characters retained
+	size_t replay (Print & output); // Writes the retained characters, oldest first
+
+	size_t write (uint8_t c);
+	size_t write (const uint8_t * buffer, size_t size);
+	using Print::write;
+
+private:
+	struct Header
+	{
+		uint32_t magic;
+		uint16_t size;
+		uint16_t head;
+		uint16_t used;
+		uint16_t check;
+	};
+
+	void readHeader ();
+	void writeHeader ();
+	uint16_t checksum () const;
+
+	Header _header; // Copy of the header stored at the beginning of the region
+	uint8_t * _region;
+	uint8_t * _data;
+	uint16_t _size;
+};
+
+#endif // ifndef AL_RETENTION_H
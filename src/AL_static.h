@@ -0,0 +1,125 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_STATIC_H
+#define AL_STATIC_H
+
+#include <ArduinoLogger.h>
+
+// Sink writing to a global Print object, e.g. PrintSink<HardwareSerial, Serial>
+// As the object is known at compile time, its write function does not need a virtual call
+template <class T, T & object>
+struct PrintSink
+{
+	static inline void write (const char * str, size_t len)
+	{
+		object.write (str, len);
+	}
+};
+
+// Writes to every sink of the list, unrolled at compile time
+template <class ... Sinks>
+struct SinkList;
+
+template <>
+struct SinkList<>
+{
+	static inline void write (const char * str, size_t len)
+	{
+		(void) str;
+		(void) len;
+	}
+};
+
+template <class Sink, class ... Others>
+struct SinkList<Sink, Others ...>
+{
+	static inline void write (const char * str, size_t len)
+	{
+		Sink::write (str, len);
+		SinkList<Others ...>::write (str, len);
+	}
+};
+
+// Prefix properties of a StaticLogger, in a registry of its own so the line manipulators (endl, np...) work as usual
+struct StaticLoggerOutput
+{
+	StaticLoggerOutput(bool prefixEnabled, uint8_t timeMode) : _output(), _registry()
+	{
+		_output.level             = LOG_LEVEL_VERBOSE;
+		_output.timeMode          = timeMode;
+		_output.prefixEnabled     = prefixEnabled;
+		_output.prefixOnNextPrint = prefixEnabled;
+		_output.dateEnabled       = true;
+		_output.levelNameEnabled  = true;
+
+		_registry.outputs    = &_output;
+		_registry.maxOutputs = 1;
+		_registry.nOutputs   = 1;
+	}
+
+	LogOutput _output;
+	LogRegistry _registry;
+};
+
+// Logger writing to a set of sinks fixed at compile time, e.g.
+// StaticLogger<PrintSink<HardwareSerial, Serial>, PrintSink<File, logFile> > sinf (LOG_LEVEL_INFO);
+// Each sink is a type with a static write (const char * str, size_t len) function
+// The fan-out is inlined, without output registry nor virtual call to the outputs
+// The outputs configuration functions (add, edit, npo, dsb...) have no effect on it
+template <class ... Sinks>
+class StaticLogger : private StaticLoggerOutput, public ArduinoLogger
+{
+public:
+	// The prefix layout follows the format of ArduinoLogger::setPrefix (), NULL for the default one
+	StaticLogger(uint8_t levelToOutput, bool prefixEnabled = true, uint8_t timeMode = LOG_TIME_DATE,
+	  const char * prefix = NULL) :
+		StaticLoggerOutput (prefixEnabled, timeMode),
+		ArduinoLogger (levelToOutput, StaticLoggerOutput::_registry)
+	{
+		compilePrefix (&_output, prefix ? prefix : "[%T] [%L] ");
+	}
+
+private:
+	void putch (char c)
+	{
+		putstr (&c, 1);
+	}
+
+	void putstr (const char * str, size_t len)
+	{
+		if (_output.prefixOnNextPrint)
+		{
+			char prefix[AL_PREFIX_BUFFER_SIZE];
+
+			SinkList<Sinks ...>::write (prefix, renderPrefix (&_output, prefix));
+			_output.prefixOnNextPrint = false;
+		}
+
+		SinkList<Sinks ...>::write (str, len);
+	}
+};
+
+#endif // ifndef AL_STATIC_H
@@ -0,0 +1,249 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "AL_syslog.h"
+
+// Syslog severity of each log level
+static const uint8_t severities[] = {
+	5, // LOG_LEVEL_SILENT  : notice
+	3, // LOG_LEVEL_ERROR   : error
+	4, // LOG_LEVEL_WARNING : warning
+	6, // LOG_LEVEL_INFO    : informational
+	7, // LOG_LEVEL_TRACE   : debug
+	7  // LOG_LEVEL_VERBOSE : debug
+};
+
+SyslogSink::SyslogSink (UDP & udp, IPAddress server, uint16_t port) :
+	_udp (udp), _server (server), _port (port),
+	_hostname ("-"), _appName ("-"), _clock (NULL),
+	_facility (SYSLOG_FACILITY_LOCAL0), _severity (severities[LOG_LEVEL_SILENT]),
+	_mtu (0), _maxDelay (0), _firstMessageTime (0),
+	_inMessage (false), _messageStart (0), _length (0)
+{ }
+
+void SyslogSink::setHostname (const char * hostname)
+{
+	_hostname = hostname;
+}
+
+void SyslogSink::setAppName (const char * appName)
+{
+	_appName = appName;
+}
+
+void SyslogSink::setFacility (uint8_t facility)
+{
+	_facility = facility;
+}
+
+void SyslogSink::setClock (LogClock & clock)
+{
+	_clock = &clock;
+}
+
+void SyslogSink::setBatching (uint16_t mtu, uint16_t maxDelay)
+{
+	_mtu      = mtu < sizeof(_buffer) ? mtu : sizeof(_buffer);
+	_maxDelay = maxDelay;
+}
+
+void SyslogSink::send ()
+{
+	if (!_inMessage)
+		sendPacket (_length);
+	else if (_messageStart)
+		sendPacket (_messageStart - 1); // Without the current message and its separator
+}
+
+void SyslogSink::poll ()
+{
+	if (_length && millis() - _firstMessageTime >= _maxDelay)
+		send();
+}
+
+void SyslogSink::beginLine (uint8_t level)
+{
+	_severity = severities[level <= LOG_LEVEL_VERBOSE ? level : LOG_LEVEL_VERBOSE];
+}
+
+void SyslogSink::endLine ()
+{
+	if (_inMessage)
+		closeMessage();
+
+	_severity = severities[LOG_LEVEL_SILENT];
+}
+
+size_t SyslogSink::write (uint8_t c)
+{
+	return write (&c, 1);
+}
+
+size_t SyslogSink::write (const uint8_t * buffer, size_t size)
+{
+	const char * str = (const char *) buffer;
+	const char * end = str + size;
+
+	// Each line of the text is a message
+	while (str < end)
+	{
+		const char * eol = (const char *) memchr (str, '\n', end - str);
+
+		if (!_inMessage)
+			openMessage();
+
+		append (str, (eol ? eol : end) - str);
+
+		if (!eol)
+			break;
+
+		closeMessage();
+		str = eol + 1;
+	}
+
+	return size;
+}
+
+void SyslogSink::openMessage ()
+{
+	char header[64];
+	char * ptr = header;
+
+	if (_length)
+		append ("\n", 1); // Separator between the messages of a datagram
+	else
+		_firstMessageTime = millis();
+
+	// <PRI>VERSION
+	*ptr++ = '<';
+	ptr    = logFmtDec (ptr, _facility * 8 + _severity);
+	*ptr++ = '>';
+	*ptr++ = '1';
+	*ptr++ = ' ';
+
+	// TIMESTAMP
+	if (_clock)
+	{
+		LogTime time;
+		LogDate date;
+
+		_clock->now (time);
+		logDate (time.sec, date);
+
+		ptr    = logFmtDec (ptr, date.year, 4);
+		*ptr++ = '-';
+		ptr    = logFmtDec (ptr, date.month, 2);
+		*ptr++ = '-';
+		ptr    = logFmtDec (ptr, date.day, 2);
+		*ptr++ = 'T';
+		ptr    = logFmtDec (ptr, date.hour, 2);
+		*ptr++ = ':';
+		ptr    = logFmtDec (ptr, date.minute, 2);
+		*ptr++ = ':';
+		ptr    = logFmtDec (ptr, date.second, 2);
+		*ptr++ = '.';
+		ptr    = logFmtDec (ptr, time.usec / 1000, 3);
+		*ptr++ = 'Z';
+	}
+	else
+	{
+		*ptr++ = '-';
+	}
+	*ptr++ = ' ';
+
+	_inMessage    = true;
+	_messageStart = _length;
+
+	// HOSTNAME APP-NAME PROCID MSGID STRUCTURED-DATA
+	append (header, ptr - header);
+	append (_hostname, strlen (_hostname));
+	append (" ", 1);
+	append (_appName, strlen (_appName));
+	append (" - - - ", 7);
+} // SyslogSink::openMessage
+
+void SyslogSink::closeMessage ()
+{
+	_inMessage = false;
+
+	if (_length > _messageStart && _buffer[_length - 1] == '\r')
+		_length--;
+
+	if (!_mtu)
+	{
+		sendPacket (_length);
+		return;
+	}
+
+	// The message does not fit with the previous ones: they are sent first
+	if (_length > _mtu && _messageStart)
+		sendPacket (_messageStart - 1);
+
+	if (_length >= _mtu || millis() - _firstMessageTime >= _maxDelay)
+		sendPacket (_length);
+}
+
+void SyslogSink::append (const char * str, size_t len)
+{
+	// The current message does not fit after the previous ones: they are sent first, moving it at the beginning
+	if (len > sizeof(_buffer) - _length && _inMessage && _messageStart)
+		sendPacket (_messageStart - 1);
+
+	// Only a message longer than the whole buffer is truncated
+	size_t room = sizeof(_buffer) - _length;
+
+	if (len > room)
+		len = room;
+
+	memcpy (_buffer + _length, str, len);
+	_length += len;
+}
+
+void SyslogSink::sendPacket (uint16_t length)
+{
+	if (!length)
+		return;
+
+	_udp.beginPacket (_server, _port);
+	_udp.write ((const uint8_t *) _buffer, length);
+	_udp.endPacket();
+
+	// Keeping what was not sent (the current message) at the beginning of the buffer
+	if (length < _length)
+	{
+		uint16_t start = _buffer[length] == '\n' ? length + 1 : length;
+
+		memmove (_buffer, _buffer + start, _length - start);
+		_length      -= start;
+		_messageStart = _messageStart >= start ? _messageStart - start : 0;
+	}
+	else
+	{
+		_length       = 0;
+		_messageStart = 0;
+	}
+
+	_firstMessageTime = millis();
+}
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_SYSLOG_H
+#define AL_SYSLOG_H
+
+#include <Arduino.h>
+#include <Udp.h>
+#include <ArduinoLogger.h>
+
+// Size of the datagram buffer, a line longer than that is truncated
+#ifndef AL_SYSLOG_BUFFER_SIZE
+# define AL_SYSLOG_BUFFER_SIZE 512
+#endif
+
+#define SYSLOG_FACILITY_USER   1
+#define SYSLOG_FACILITY_LOCAL0 16
+
+/**
+ * Output sending each line as a syslog message (RFC 5424) over UDP
+ *
+ * Add it without prefix, the syslog header already holds the time, the host and the severity:
+ * logger.add (syslog, LOG_LEVEL_INFO, false);
+ *
+ * With batching enabled, several messages separated by a line feed are sent in one datagram,
+ * the collector needs to split them (e.g. rsyslog imudp or syslog-ng with newline splitting).
+ */
+class SyslogSink : public LogSink
+{
+public:
+	SyslogSink(UDP & udp, IPAddress server, uint16_t port = 514);
+
+	void setHostname (const char * hostname); // Default is "-"
+	void setAppName (const char * appName);   // Default is "-"
+	void setFacility (uint8_t facility);      // Default is SYSLOG_FACILITY_LOCAL0
+	void setClock (LogClock & clock);         // Calendar clock for the message timestamp, default is "-"
+
+	// Pack several messages in datagrams of up to mtu bytes, sent at the latest maxDelay ms after their first message
+	// A mtu of 0 sends one datagram per message (default), a mtu above AL_SYSLOG_BUFFER_SIZE is lowered to it
+	void setBatching (uint16_t mtu, uint16_t maxDelay);
+
+	void send (); // Sends the pending messages now
+	void poll (); // Sends the pending messages if they waited for too long, to call in loop ()
+
+	void beginLine (uint8_t level);
+	void endLine ();
+
+	size_t write (uint8_t c);
+	size_t write (const uint8_t * buffer, size_t size);
+	using Print::write;
+
+private:
+	void openMessage ();
+	void closeMessage ();
+	void append (const char * str, size_t len);
+	void sendPacket (uint16_t length);
+
+	UDP & _udp;
+	IPAddress _server;
+	uint16_t _port;
+
+	const char * _hostname;
+	const char * _appName;
+	LogClock * _clock;
+	uint8_t _facility;
+	uint8_t _severity;
+
+	uint16_t _mtu;
+	uint16_t _maxDelay;
+	uint32_t _firstMessageTime;
+
+	bool _inMessage;
+	uint16_t _messageStart; // Start of the current message in the buffer
+	uint16_t _length;       // Length of the buffer content
+	char _buffer[AL_SYSLOG_BUFFER_SIZE];
+};
+
+#endif // ifndef AL_SYSLOG_H
@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#include "AL_timer.h"
+
+void logTimerEnd (ArduinoLogger * logger, uint8_t level, const char * label, uint32_t duration)
+{
+	ArduinoLogger & out = logger ? *logger : levelLogger (level);
+
+	if (out.isActive())
+		out << label << F (": ") << duration << F (" us") << endl;
+}
+
+LogTimerStats::LogTimerStats (const char * label, uint16_t period) :
+	_label (label), _period (period ? period : 1), _count (0), _min (0xFFFFFFFF), _max (0), _total (0)
+{ }
+
+void LogTimerStats::add (ArduinoLogger * logger, uint8_t level, uint32_t duration)
+{
+	if (duration < _min)
+		_min = duration;
+	if (duration > _max)
+		_max = duration;
+	_total += duration;
+
+	if (++_count < _period)
+		return;
+
+	ArduinoLogger & out = logger ? *logger : levelLogger (level);
+
+	if (out.isActive())
+	{
+		out << _label << F (": min=") << _min << F (" avg=") << _total / _count << F (" max=") << _max
+		    << F (" us (") << _count << ')' << endl;
+	}
+
+	_count = 0;
+	_min   = 0xFFFFFFFF;
+	_max   = 0;
+	_total = 0;
+}
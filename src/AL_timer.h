@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_TIMER_H
+#define AL_TIMER_H
+
+#include <ArduinoLogger.h>
+
+// Highest level of the compiled timers, the timers of the levels above do nothing and cost nothing
+#ifndef AL_TIMER_LEVEL
+# define AL_TIMER_LEVEL LOG_LEVEL_VERBOSE
+#endif
+
+// Min, average and max of the durations of a timed scope, output every period samples
+// Must outlive the timers using it (static or global)
+class LogTimerStats
+{
+public:
+	LogTimerStats(const char * label, uint16_t period);
+
+	void add (ArduinoLogger * logger, uint8_t level, uint32_t duration);
+
+private:
+	const char * _label;
+	uint16_t _period;
+	uint16_t _count;
+	uint32_t _min;
+	uint32_t _max;
+	uint32_t _total;
+};
+
+// Outputs the duration of a timed scope
+void logTimerEnd (ArduinoLogger * logger, uint8_t level, const char * label, uint32_t duration);
+
+/**
+ * Outputs the time spent in its scope when destroyed, e.g. "parse: 132 us":
+ *
+ * LogTimer<LOG_LEVEL_TRACE> timer ("parse");         // Through trace
+ * LogTimer<LOG_LEVEL_TRACE> timer ("parse", d.trace); // Through a logger of a domain
+ *
+ * static LogTimerStats stats ("loop", 100);
+ * LogTimer<LOG_LEVEL_INFO> timer (stats);            // "loop: min=12 avg=15 max=40 us (100)" every 100 loops
+ */
+template <uint8_t Level, bool Compiled = (Level <= AL_TIMER_LEVEL)>
+class LogTimer
+{
+public:
+	explicit LogTimer(const char * label, ArduinoLogger * logger = NULL) :
+		_label (label), _stats (NULL), _logger (logger), _start (micros()){ }
+
+	LogTimer(const char * label, ArduinoLogger & logger) :
+		_label (label), _stats (NULL), _logger (&logger), _start (micros()){ }
+
+	explicit LogTimer(LogTimerStats & stats, ArduinoLogger * logger = NULL) :
+		_label (NULL), _stats (&stats), _logger (logger), _start (micros()){ }
+
+	LogTimer(LogTimerStats & stats, ArduinoLogger & logger) :
+		_label (NULL), _stats (&stats), _logger (&logger), _start (micros()){ }
+
+	~LogTimer()
+	{
+		uint32_t duration = micros() - _start;
+
+		if (_stats)
+			_stats->add (_logger, Level, duration);
+		else
+			logTimerEnd (_logger, Level, _label, duration);
+	}
+
+private:
+	LogTimer(const LogTimer &);
+	LogTimer & operator = (const LogTimer &);
+
+	const char * _label;
+	LogTimerStats * _stats;
+	ArduinoLogger * _logger; // NULL for the global logger of the level
+	uint32_t _start;
+};
+
+// Timer of a level above AL_TIMER_LEVEL
+template <uint8_t Level>
+class LogTimer<Level, false>
+{
+public:
+	explicit LogTimer(const char *, ArduinoLogger * = NULL){ }
+
+	LogTimer(const char *, ArduinoLogger &){ }
+
+	explicit LogTimer(LogTimerStats &, ArduinoLogger * = NULL){ }
+
+	LogTimer(LogTimerStats &, ArduinoLogger &){ }
+};
+
+#define AL_TIMER_CONCAT2(a, b) a ## b
+#define AL_TIMER_CONCAT(a, b)  AL_TIMER_CONCAT2 (a, b)
+
+// Times the rest of the current scope: LOG_TIMED (LOG_LEVEL_TRACE, "parse");
+#define LOG_TIMED(level, ...) LogTimer<level> AL_TIMER_CONCAT (alTimer, __LINE__) (__VA_ARGS__)
+
+#endif // ifndef AL_TIMER_H
@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2020 Farès Chati
+ * This file id part of the ArduinoLogger library.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef AL_TRAITS_H
+#define AL_TRAITS_H
+
+#include <stddef.h>
+
+// Type traits shared by the compile-time type dispatch of the library (no <type_traits> on AVR)
+namespace al_traits {
+template <class T> struct RemoveCV { typedef T type; };
+template <class T> struct RemoveCV<const T> { typedef T type; };
+template <class T> struct RemoveCV<volatile T> { typedef T type; };
+template <class T> struct RemoveCV<const volatile T> { typedef T type; };
+
+template <class T> struct IsIntegralType { static constexpr bool value = false; };
+template <> struct IsIntegralType<bool> { static constexpr bool value = true; };
+template <> struct IsIntegralType<char> { static constexpr bool value = true; };
+template <> struct IsIntegralType<signed char> { static constexpr bool value = true; };
+template <> struct IsIntegralType<unsigned char> { static constexpr bool value = true; };
+template <> struct IsIntegralType<short> { static constexpr bool value = true; };
+template <> struct IsIntegralType<unsigned short> { static constexpr bool value = true; };
+template <> struct IsIntegralType<int> { static constexpr bool value = true; };
+template <> struct IsIntegralType<unsigned int> { static constexpr bool value = true; };
+template <> struct IsIntegralType<long> { static constexpr bool value = true; };
+template <> struct IsIntegralType<unsigned long> { static constexpr bool value = true; };
+template <> struct IsIntegralType<long long> { static constexpr bool value = true; };
+template <> struct IsIntegralType<unsigned long long> { static constexpr bool value = true; };
+
+template <class T> struct IsFloatType { static constexpr bool value = false; };
+template <> struct IsFloatType<float> { static constexpr bool value = true; };
+template <> struct IsFloatType<double> { static constexpr bool value = true; };
+
+// Integer types, bool included, whatever their cv-qualifiers
+template <class T>
+struct IsIntegral { static constexpr bool value = IsIntegralType<typename RemoveCV<T>::type>::value; };
+
+// float and double, whatever their cv-qualifiers
+template <class T>
+struct IsFloat { static constexpr bool value = IsFloatType<typename RemoveCV<T>::type>::value; };
+
+// Storage of a number type: size in bytes, signedness and floating point
+// bool is an unsigned 1-byte integer, 64-bit integers are flagged for the users that do not support them
+template <class T>
+struct Number
+{
+	typedef typename RemoveCV<T>::type type;
+
+	static_assert (IsIntegral<type>::value || IsFloat<type>::value, "not an integer or floating point type");
+
+	static constexpr bool isFloat   = IsFloat<type>::value;
+	static constexpr bool isSigned  = isFloat || type (-1) < type (0);
+	static constexpr size_t size    = sizeof(type);
+	static constexpr bool isInt64   = !isFloat && size > 4;
+};
+} // namespace al_traits
+
+#endif // ifndef AL_TRAITS_H
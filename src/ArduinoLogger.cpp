@@ -25,38 +25,100 @@
 
 #include "ArduinoLogger.h"
 
-LogOutput * ArduinoLogger::_outputs = NULL;
-uint8_t ArduinoLogger::_nOutputs    = 0;
-uint8_t ArduinoLogger::_nDisplayed  = 0;
-char ArduinoLogger::clock[30];
+char ArduinoLogger::clock[24];
+
+#if AL_USE_TIMELIB
+static TimeLibClock defaultClock;
+#else
+static MillisClock defaultClock;
+#endif
+LogClock * ArduinoLogger::_clock = &defaultClock;
+
+// Prefix layout operations, the values below PREFIX_CLOCK are the lengths of the literal parts
+#define PREFIX_END       0x00 // End of the prefix
+#define PREFIX_CLOCK     0x80 // Clock, in the time mode of the output
+#define PREFIX_LEVEL     0x81 // Level name
+#define PREFIX_INDEX     0x82 // Output index: 1|2
+#define PREFIX_INDEX_TAG 0x83 // Output index tag: [1|2]
+
+// ANSI escape code coloring the level name of each level
+static const char * levelColor (uint8_t level)
+{
+	switch (level)
+	{
+		case LOG_LEVEL_ERROR:
+			return "\033[31m"; // Red
+
+		case LOG_LEVEL_WARNING:
+			return "\033[33m"; // Yellow
+
+		case LOG_LEVEL_INFO:
+			return "\033[32m"; // Green
+
+		case LOG_LEVEL_TRACE:
+			return "\033[36m"; // Cyan
+
+		default:
+			return "\033[37m"; // White
+	}
+}
+
+static LogOutput defaultOutputs[AL_MAX_OUTPUTS];
+static LogRegistry defaultRegistry = { defaultOutputs, AL_MAX_OUTPUTS, 0, 0, NULL, LogOutput(), LOG_LEVEL_ERROR, 0 };
+
+// Microseconds counter of a time, wraps every 71 minutes like micros()
+static uint32_t toMicros (const LogTime & time)
+{
+	return time.sec * 1000000UL + time.usec;
+}
 
-ArduinoLogger::ArduinoLogger() : _levelToOutput (LOG_LEVEL_SILENT)
+ArduinoLogger::ArduinoLogger() : _levelToOutput (LOG_LEVEL_SILENT), _registry (&defaultRegistry)
 { }
 
-ArduinoLogger::ArduinoLogger (uint8_t levelToOutput) : _levelToOutput (levelToOutput)
+ArduinoLogger::ArduinoLogger (uint8_t levelToOutput) : _levelToOutput (levelToOutput), _registry (&defaultRegistry)
 {
 	setflags();
 }
 
-void ArduinoLogger::add (Print & stream, uint8_t level, bool prefixEnabled, bool dateEnabled, bool levelNameEnabled) const
+ArduinoLogger::ArduinoLogger (LogRegistry & registry) : _levelToOutput (LOG_LEVEL_SILENT), _registry (&registry)
+{ }
+
+ArduinoLogger::ArduinoLogger (uint8_t levelToOutput, LogRegistry & registry) : _levelToOutput (levelToOutput), _registry (&registry)
 {
-	LogOutput * oldOutputs = _outputs;
+	setflags();
+}
 
+LogDomain::LogDomain() :
+	_outputs(),
+	_registry(),
+	err (LOG_LEVEL_ERROR, _registry),
+	warn (LOG_LEVEL_WARNING, _registry),
+	inf (LOG_LEVEL_INFO, _registry),
+	trace (LOG_LEVEL_TRACE, _registry),
+	verb (LOG_LEVEL_VERBOSE, _registry),
+	logger (_registry)
+{
+	_registry.outputs    = _outputs;
+	_registry.maxOutputs = AL_MAX_OUTPUTS;
+}
+
+void ArduinoLogger::add (Print & stream, uint8_t level, bool prefixEnabled, bool dateEnabled, bool levelNameEnabled) const
+{
 	// If the ouput is already present, just edit it
 	if (getLogOutputFromStream (stream) != NULL)
 		edit (stream, level, prefixEnabled, dateEnabled, levelNameEnabled);
-	else
-	{
-		_outputs = new LogOutput[++_nOutputs]; // Incrementing the counter and creating a new array with one more item
+	else if (_registry->nOutputs < _registry->maxOutputs)
+		initLogOutput (&_registry->outputs[_registry->nOutputs++], stream, level, prefixEnabled, dateEnabled, levelNameEnabled); // Initializing the new item
+}
 
-		// Copying the existing array
-		for (int i = 0; i < _nOutputs - 1; i++)
-			_outputs[i] = oldOutputs[i];
+void ArduinoLogger::add (LogSink & sink, uint8_t level, bool prefixEnabled, bool dateEnabled, bool levelNameEnabled) const
+{
+	add ((Print &) sink, level, prefixEnabled, dateEnabled, levelNameEnabled);
 
-		delete oldOutputs; // Then, removing the old array
+	LogOutput * output = getLogOutputFromStream (sink);
 
-		initLogOutput (&_outputs[_nOutputs - 1], stream, level, prefixEnabled, dateEnabled, levelNameEnabled); // Initializing the new item
-	}
+	if (output != NULL)
+		output->sink = &sink;
 }
 
 void ArduinoLogger::edit (Print & stream, uint8_t level, bool prefixEnabled, bool dateEnabled, bool levelNameEnabled) const
@@ -78,6 +140,16 @@ void ArduinoLogger::enable (Print & stream) const
 	updateNDisplayed();
 }
 
+void ArduinoLogger::enableColor (Print & stream) const
+{
+	LogOutput * output = getLogOutputFromStream (stream);
+
+	if (!output)
+		return;
+
+	output->colorEnabled = true;
+}
+
 void ArduinoLogger::disable (Print & stream) const
 {
 	LogOutput * output = getLogOutputFromStream (stream);
@@ -107,6 +179,7 @@ void ArduinoLogger::enableDate (Print & stream) const
 		return;
 
 	output->dateEnabled = true;
+	updatePrefix (output);
 }
 
 void ArduinoLogger::enableLevelName (Print & stream) const
@@ -117,6 +190,7 @@ void ArduinoLogger::enableLevelName (Print & stream) const
 		return;
 
 	output->levelNameEnabled = true;
+	updatePrefix (output);
 }
 
 void ArduinoLogger::disablePrefix (Print & stream) const
@@ -137,6 +211,7 @@ void ArduinoLogger::disableDate (Print & stream) const
 		return;
 
 	output->dateEnabled = false;
+	updatePrefix (output);
 }
 
 void ArduinoLogger::disableLevelName (Print & stream) const
@@ -147,6 +222,72 @@ void ArduinoLogger::disableLevelName (Print & stream) const
 		return;
 
 	output->levelNameEnabled = false;
+	updatePrefix (output);
+}
+
+void ArduinoLogger::disableColor (Print & stream) const
+{
+	LogOutput * output = getLogOutputFromStream (stream);
+
+	if (!output)
+		return;
+
+	output->colorEnabled = false;
+}
+
+void ArduinoLogger::setPrefix (Print & stream, const char * pattern) const
+{
+	LogOutput * output = getLogOutputFromStream (stream);
+
+	if (!output)
+		return;
+
+	output->customPrefix = pattern != NULL;
+
+	if (pattern)
+		compilePrefix (output, pattern);
+	else
+		updatePrefix (output);
+}
+
+void ArduinoLogger::setTimeMode (Print & stream, uint8_t timeMode) const
+{
+	LogOutput * output = getLogOutputFromStream (stream);
+
+	if (!output)
+		return;
+
+	LogTime time;
+
+	_clock->now (time);
+
+	output->timeMode     = constrain (timeMode, LOG_TIME_DATE, LOG_TIME_EPOCH);
+	output->lastLineTime = toMicros (time);
+}
+
+void ArduinoLogger::setClock (LogClock & clock) const
+{
+	LogTime time;
+
+	_clock = &clock;
+	_clock->now (time);
+
+	for (uint8_t i = 0; i < _registry->nOutputs; i++)
+		_registry->outputs[i].lastLineTime = toMicros (time);
+}
+
+void ArduinoLogger::record (FlightRecorder & recorder, uint8_t level, uint8_t trigger) const
+{
+	initLogOutput (&_registry->recorderOutput, recorder, level, true, true, true);
+	_registry->recorderOutput.displayIndex = 0; // The output counter is not recorded
+
+	_registry->flightRecorder = &recorder;
+	_registry->recordTrigger  = trigger;
+}
+
+void ArduinoLogger::stopRecording () const
+{
+	_registry->flightRecorder = NULL;
 }
 
 bool ArduinoLogger::isEnabled (Print & stream, int level) const
@@ -159,26 +300,116 @@ bool ArduinoLogger::isEnabled (Print & stream, int level) const
 	return output->enabled() && output->level >= level;
 }
 
+bool ArduinoLogger::isActive () const
+{
+	if (_registry->flightRecorder != NULL && _levelToOutput >= _registry->recorderOutput.level)
+		return true;
+
+	for (uint8_t i = 0; i < _registry->nOutputs; i++)
+		if (_registry->outputs[i].enabled() && _registry->outputs[i].level >= _levelToOutput)
+			return true;
+
+	return false;
+}
+
+size_t ArduinoLogger::service (uint32_t budgetMicros) const
+{
+	uint32_t start  = micros();
+	uint8_t nOutputs = _registry->nOutputs;
+	uint8_t idle    = 0; // Outputs in a row without progress
+
+	for (uint8_t i = _registry->serviceNext; nOutputs && idle < nOutputs; i = i + 1 < nOutputs ? i + 1 : 0)
+	{
+		LogOutput * output = &_registry->outputs[i];
+		size_t pending     = output->sink ? output->sink->pending() : 0;
+		uint32_t elapsed   = micros() - start;
+
+		if (elapsed >= budgetMicros)
+			break;
+
+		if (!pending)
+		{
+			idle++;
+			continue;
+		}
+
+		// Characters that can be written in the remaining time, a single one until the speed is known
+		uint32_t remaining  = budgetMicros - elapsed < 0x0FFFFFFF ? budgetMicros - elapsed : 0x0FFFFFFF;
+		uint32_t affordable = output->drainCost ? remaining * 16 / output->drainCost : 1;
+		size_t chunk        = pending < AL_SERVICE_CHUNK ? pending : AL_SERVICE_CHUNK;
+
+		if (affordable < chunk)
+			chunk = affordable;
+
+		if (!chunk)
+		{
+			// The estimate decays while the output is skipped, so that one slow measurement
+			// (e.g. a full transmit buffer) does not keep it from being drained for good
+			output->drainCost = (output->drainCost + 1) / 2;
+			idle++;
+			continue;
+		}
+
+		uint32_t before = micros();
+		size_t written  = output->sink->drain (chunk);
+
+		if (written)
+		{
+			uint32_t cost = (micros() - before) * 16 / written;
+
+			cost = constrain (cost, 1, 0xFFFF);
+			output->drainCost = output->drainCost ? (3 * (uint32_t) output->drainCost + cost) / 4 : cost;
+			idle = 0;
+		}
+		else
+		{
+			idle++;
+		}
+
+		_registry->serviceNext = i + 1 < nOutputs ? i + 1 : 0;
+	}
+
+	size_t backlog = 0;
+
+	for (uint8_t i = 0; i < nOutputs; i++)
+		if (_registry->outputs[i].sink)
+			backlog += _registry->outputs[i].sink->pending();
+
+	return backlog;
+} // ArduinoLogger::service
+
 LogOutput * ArduinoLogger::getLogOutputFromStream (Print & stream) const
 {
-	for (uint8_t i = 0; i < _nOutputs; i++)
-		if (_outputs[i].stream == &stream)
-			return &_outputs[i];
+	for (uint8_t i = 0; i < _registry->nOutputs; i++)
+		if (_registry->outputs[i].stream == &stream)
+			return &_registry->outputs[i];
 
 	return NULL;
 }
 
 void ArduinoLogger::initLogOutput (LogOutput * output, Print & stream, uint8_t level, bool prefixEnabled, bool dateEnabled, bool levelNameEnabled) const
 {
+	LogTime time;
+
+	_clock->now (time);
+
+	bool editing = output->stream == &stream;
+
+	output->sink              = editing ? output->sink : NULL; // Kept when editing
+	output->customPrefix      = editing && output->customPrefix;
+	output->colorEnabled      = editing && output->colorEnabled;
 	output->stream            = &stream;
 	output->level             = constrain (level, LOG_LEVEL_SILENT, LOG_LEVEL_VERBOSE);
 	output->prefixEnabled     = prefixEnabled;
 	output->prefixOnNextPrint = prefixEnabled;
-	output->dateEnabled       = true;
-	output->levelNameEnabled  = true;
+	output->dateEnabled       = dateEnabled;
+	output->levelNameEnabled  = levelNameEnabled;
+	output->timeMode          = editing ? output->timeMode : LOG_TIME_DATE;
+	output->lastLineTime      = toMicros (time);
 	output->disabled          = false;
 	output->tempDisabled      = false;
 
+	updatePrefix (output);
 	updateDisplayIndex();
 	updateNDisplayed();
 }
@@ -220,6 +451,7 @@ ArduinoLogger & operator << (ArduinoLogger & os, const dsb & arg)
 ArduinoLogger & endl (ArduinoLogger & logger)
 {
 	logger.put ('\n');
+	logger.endLine();
 	logger.setPrefixOnNextPrint (true);
 	logger.setflags();
 	logger.resetTempDisabled();
@@ -248,6 +480,7 @@ ArduinoLogger & np (ArduinoLogger & logger)
 ArduinoLogger & cr (ArduinoLogger & logger)
 {
 	logger.put ('\r');
+	logger.endLine();
 	logger.setPrefixOnNextPrint (true);
 	logger.setflags();
 	logger.resetTempDisabled();
@@ -255,24 +488,46 @@ ArduinoLogger & cr (ArduinoLogger & logger)
 	return logger;
 }
 
-void ArduinoLogger::putch (char c)
+// End of a record
+ArduinoLogger & eor (ArduinoLogger & logger)
 {
-	char str[2];
+	logger.endLine();
+	logger.setPrefixOnNextPrint (true);
+	logger.setflags();
+	logger.resetTempDisabled();
 
-	str[0] = c;
-	str[1] = '\0';
+	return logger;
+}
 
-	putstr (str);
+void ArduinoLogger::putch (char c)
+{
+	putstr (&c, 1);
 }
 
-void ArduinoLogger::putstr (const char * str)
+void ArduinoLogger::putstr (const char * str, size_t len)
 {
-	for (uint8_t i = 0; i < _nOutputs; i++)
+	if (_registry->flightRecorder)
 	{
-		if (_outputs[i].enabled() && _outputs[i].level >= _levelToOutput)
+		if (_levelToOutput >= _registry->recorderOutput.level)
 		{
-			printPrefix (i);
-			_outputs[i].stream->write (str);
+			printPrefix (&_registry->recorderOutput);
+			_registry->flightRecorder->write (str, len);
+			return;
+		}
+
+		if (_levelToOutput <= _registry->recordTrigger && _registry->flightRecorder->recorded())
+			dumpRecorder();
+	}
+
+	for (uint8_t i = 0; i < _registry->nOutputs; i++)
+	{
+		if (_registry->outputs[i].enabled() && _registry->outputs[i].level >= _levelToOutput)
+		{
+			LogOutput * output = &_registry->outputs[i];
+
+			beginLine (output);
+			printSharedPrefix (i);
+			output->stream->write (str, len);
 		}
 	}
 }
@@ -300,74 +555,298 @@ ArduinoLogger::pos_type ArduinoLogger::tellpos ()
 	return 0;
 }
 
-void ArduinoLogger::printPrefix (uint8_t index)
+void ArduinoLogger::dumpRecorder ()
 {
-	LogOutput * output = &_outputs[index];
+	for (uint8_t i = 0; i < _registry->nOutputs; i++)
+	{
+		if (_registry->outputs[i].enabled() && _registry->outputs[i].level >= _levelToOutput)
+		{
+			// The context is part of the line it explains for the sinks (same queue lane, ahead of it)
+			beginLine (&_registry->outputs[i]);
+			_registry->flightRecorder->dump (*_registry->outputs[i].stream);
+		}
+	}
 
+	_registry->flightRecorder->clear();
+}
+
+void ArduinoLogger::printPrefix (LogOutput * output)
+{
 	if (output->prefixEnabled && output->prefixOnNextPrint)
 	{
-		Print * stream = output->stream;
+		char prefix[AL_PREFIX_BUFFER_SIZE];
+
+		output->stream->write (prefix, renderPrefix (output, prefix));
+		output->prefixOnNextPrint = false;
+	}
+}
 
-		if (output->dateEnabled)
+// Renders the prefix of an output once for all the following outputs using the same prefix
+void ArduinoLogger::printSharedPrefix (uint8_t index)
+{
+	LogOutput * output = &_registry->outputs[index];
+
+	if (!output->prefixEnabled || !output->prefixOnNextPrint)
+		return;
+
+	char prefix[AL_PREFIX_BUFFER_SIZE];
+	uint8_t len = renderPrefix (output, prefix);
+
+	for (uint8_t i = index; i < _registry->nOutputs; i++)
+	{
+		LogOutput * other = &_registry->outputs[i];
+
+		if (other != output)
 		{
-			stream->print (F ("["));
-			stream->print (getClock());
-			stream->print (F ("] "));
+			if (!other->enabled() || other->level < _levelToOutput ||
+			  !other->prefixEnabled || !other->prefixOnNextPrint || !samePrefix (output, other))
+				continue;
+
+			beginLine (other);
 		}
 
-		if (_nDisplayed > 1)
+		other->stream->write (prefix, len);
+		other->prefixOnNextPrint = false;
+	}
+}
+
+bool ArduinoLogger::samePrefix (const LogOutput * a, const LogOutput * b) const
+{
+	// A delta clock depends on the previous line of each output
+	if (a->timeMode != b->timeMode || a->timeMode == LOG_TIME_DELTA || a->colorEnabled != b->colorEnabled)
+		return false;
+
+	if (a->prefixIndexed && _registry->nDisplayed > 1 && a->displayIndex != b->displayIndex)
+		return false;
+
+	return memcmp (a->prefixCode, b->prefixCode, AL_PREFIX_CODE_SIZE) == 0;
+}
+
+void ArduinoLogger::beginLine (LogOutput * output)
+{
+	if (output->sink && !output->lineStarted)
+	{
+		output->sink->beginLine (_levelToOutput);
+		output->lineStarted = true;
+	}
+}
+
+uint8_t ArduinoLogger::renderPrefix (LogOutput * output, char * buffer)
+{
+	const uint8_t * code = output->prefixCode;
+	char * ptr = buffer;
+
+	for (;;)
+	{
+		uint8_t op = *code++;
+
+		if (op < PREFIX_CLOCK) // Literal
 		{
-			stream->print (F ("["));
-			stream->print (_outputs[index].displayIndex);
-			stream->print (F ("|"));
-			stream->print (_nDisplayed);
-			stream->print (F ("] "));
+			if (op == PREFIX_END)
+				break;
+
+			memcpy (ptr, code, op);
+			ptr  += op;
+			code += op;
+			continue;
 		}
 
-		if (output->levelNameEnabled)
+		switch (op)
 		{
-			stream->print (F ("["));
-			stream->print (debugLevelName (_levelToOutput));
-			stream->print (F ("] "));
+			case PREFIX_CLOCK:
+			{
+				uint8_t n = getClock (output);
+
+				memcpy (ptr, clock, n);
+				ptr += n;
+				break;
+			}
+
+			case PREFIX_LEVEL:
+				if (output->colorEnabled)
+				{
+					memcpy (ptr, levelColor (_levelToOutput), 5);
+					memcpy (ptr + 5, debugLevelName (_levelToOutput), 7);
+					memcpy (ptr + 12, "\033[0m", 4);
+					ptr += 16;
+				}
+				else
+				{
+					memcpy (ptr, debugLevelName (_levelToOutput), 7);
+					ptr += 7;
+				}
+				break;
+
+			default: // PREFIX_INDEX or PREFIX_INDEX_TAG
+				if (_registry->nDisplayed > 1 && output->displayIndex)
+				{
+					if (op == PREFIX_INDEX_TAG)
+						*ptr++ = '[';
+					ptr    = logFmtDec (ptr, output->displayIndex);
+					*ptr++ = '|';
+					ptr    = logFmtDec (ptr, _registry->nDisplayed);
+					if (op == PREFIX_INDEX_TAG)
+					{
+						*ptr++ = ']';
+						*ptr++ = ' ';
+					}
+				}
+				break;
 		}
+	}
 
-		output->prefixOnNextPrint = false;
+	return ptr - buffer;
+} // ArduinoLogger::renderPrefix
+
+void ArduinoLogger::compilePrefix (LogOutput * output, const char * pattern)
+{
+	uint8_t * code    = output->prefixCode;
+	uint8_t * end     = code + AL_PREFIX_CODE_SIZE - 1; // Room for PREFIX_END
+	uint8_t * literal = NULL;                           // Length of the current literal part
+	uint8_t length    = 0;                              // Longest rendered length
+
+	memset (code, PREFIX_END, AL_PREFIX_CODE_SIZE); // Compared as a whole by samePrefix ()
+	output->prefixIndexed = false;
+
+	while (*pattern)
+	{
+		char c     = *pattern++;
+		uint8_t op = PREFIX_END;
+		uint8_t opLength;
+
+		if (c == '%')
+		{
+			switch (*pattern)
+			{
+				case 'T':
+					op       = PREFIX_CLOCK;
+					opLength = sizeof(clock);
+					break;
+
+				case 'L':
+					op       = PREFIX_LEVEL;
+					opLength = 16; // Colored
+					break;
+
+				case 'O':
+					op       = PREFIX_INDEX;
+					opLength = 7; // 255|255
+					break;
+
+				case 'I':
+					op       = PREFIX_INDEX_TAG;
+					opLength = 10; // [255|255]
+					break;
+
+				case '%':
+					pattern++;
+					break;
+			}
+		}
+
+		if (op != PREFIX_END)
+		{
+			if (code == end || length + opLength > AL_PREFIX_BUFFER_SIZE)
+				break;
+
+			*code++ = op;
+			length += opLength;
+			output->prefixIndexed |= op == PREFIX_INDEX || op == PREFIX_INDEX_TAG;
+			literal = NULL;
+			pattern++;
+			continue;
+		}
+
+		if (length == AL_PREFIX_BUFFER_SIZE)
+			break;
+
+		if (literal && *literal < PREFIX_CLOCK - 1 && code < end)
+		{
+			(*literal)++;
+		}
+		else if (end - code >= 2)
+		{
+			literal = code;
+			*code++ = 1;
+		}
+		else
+		{
+			break;
+		}
+
+		*code++ = c;
+		length++;
 	}
-} // ArduinoLogger::printPrefix
+
+	*code = PREFIX_END;
+} // ArduinoLogger::compilePrefix
+
+void ArduinoLogger::updatePrefix (LogOutput * output) const
+{
+	if (output->customPrefix)
+		return;
+
+	char pattern[16];
+
+	pattern[0] = '\0';
+	if (output->dateEnabled)
+		strcat (pattern, "[%T] ");
+	strcat (pattern, "%I");
+	if (output->levelNameEnabled)
+		strcat (pattern, "[%L] ");
+
+	compilePrefix (output, pattern);
+}
 
 void ArduinoLogger::setPrefixOnNextPrint (bool prefixOnNextPrint) const
 {
-	for (uint8_t i = 0; i < _nOutputs; i++)
-		_outputs[i].prefixOnNextPrint = prefixOnNextPrint;
+	for (uint8_t i = 0; i < _registry->nOutputs; i++)
+		_registry->outputs[i].prefixOnNextPrint = prefixOnNextPrint;
+
+	_registry->recorderOutput.prefixOnNextPrint = prefixOnNextPrint;
+}
+
+void ArduinoLogger::endLine () const
+{
+	for (uint8_t i = 0; i < _registry->nOutputs; i++)
+	{
+		LogOutput * output = &_registry->outputs[i];
+
+		if (output->lineStarted)
+		{
+			output->sink->endLine();
+			output->lineStarted = false;
+		}
+	}
 }
 
 void ArduinoLogger::updateNDisplayed () const
 {
-	_nDisplayed = 0;
+	_registry->nDisplayed = 0;
 
-	for (uint8_t i = 0; i < _nOutputs; i++)
-		if (_outputs[i].enabled())
-			_nDisplayed++;
+	for (uint8_t i = 0; i < _registry->nOutputs; i++)
+		if (_registry->outputs[i].enabled())
+			_registry->nDisplayed++;
 }
 
 void ArduinoLogger::updateDisplayIndex () const
 {
 	uint8_t n = 0;
 
-	for (uint8_t i = 0; i < _nOutputs; i++)
-		if (_outputs[i].enabled())
-			_outputs[i].displayIndex = ++n;
+	for (uint8_t i = 0; i < _registry->nOutputs; i++)
+		if (_registry->outputs[i].enabled())
+			_registry->outputs[i].displayIndex = ++n;
 }
 
 void ArduinoLogger::resetTempDisabled () const
 {
 	bool flag = false;
 
-	for (uint8_t i = 0; i < _nOutputs; i++)
+	for (uint8_t i = 0; i < _registry->nOutputs; i++)
 	{
-		flag |= _outputs[i].tempDisabled;
+		flag |= _registry->outputs[i].tempDisabled;
 
-		_outputs[i].tempDisabled = false;
+		_registry->outputs[i].tempDisabled = false;
 	}
 
 	if (flag)
@@ -401,16 +880,92 @@ const char * ArduinoLogger::debugLevelName (uint8_t debugLevel)
 	}
 }
 
-char * ArduinoLogger::getClock ()
+uint8_t ArduinoLogger::getClock (LogOutput * output)
 {
-	sprintf (clock, "%.2d/%.2d/%.4d %.2d:%.2d:%.2d::%.3ld", day(), month(), year(), hour(), minute(), second(), (millis() % 1000));
+	char * ptr = clock;
+	LogTime time;
 
-	return clock;
-}
+	switch (output->timeMode)
+	{
+		case LOG_TIME_MILLIS:
+			ptr = logFmtDec (ptr, millis());
+			break;
+
+		case LOG_TIME_MICROS:
+			ptr = logFmtDec (ptr, micros());
+			break;
+
+		case LOG_TIME_DELTA:
+		{
+			_clock->now (time);
+
+			uint32_t us = toMicros (time);
+
+			*ptr++ = '+';
+			ptr    = logFmtDec (ptr, us - output->lastLineTime);
+			output->lastLineTime = us;
+			break;
+		}
+
+		case LOG_TIME_EPOCH:
+			_clock->now (time);
+			ptr    = logFmtDec (ptr, time.sec);
+			*ptr++ = '.';
+			ptr    = logFmtDec (ptr, time.usec / 1000, 3);
+			break;
+
+		default:
+		{
+			_clock->now (time);
+
+			LogDate date;
+
+			logDate (time.sec, date);
+			ptr    = logFmtDec (ptr, date.day, 2);
+			*ptr++ = '/';
+			ptr    = logFmtDec (ptr, date.month, 2);
+			*ptr++ = '/';
+			ptr    = logFmtDec (ptr, date.year, 4);
+			*ptr++ = ' ';
+			ptr    = logFmtDec (ptr, date.hour, 2);
+			*ptr++ = ':';
+			ptr    = logFmtDec (ptr, date.minute, 2);
+			*ptr++ = ':';
+			ptr    = logFmtDec (ptr, date.second, 2);
+			*ptr++ = ':';
+			*ptr++ = ':';
+			ptr    = logFmtDec (ptr, time.usec / 1000, 3);
+			break;
+		}
+	}
+
+	return ptr - clock;
+} // ArduinoLogger::getClock
 
 ArduinoLogger err   (LOG_LEVEL_ERROR);
 ArduinoLogger warn  (LOG_LEVEL_WARNING);
 ArduinoLogger inf   (LOG_LEVEL_INFO);
 ArduinoLogger trace (LOG_LEVEL_TRACE);
 ArduinoLogger verb  (LOG_LEVEL_VERBOSE);
-const ArduinoLogger logger;
\ No newline at end of file
+const ArduinoLogger logger;
+
+ArduinoLogger & levelLogger (uint8_t level)
+{
+	switch (level)
+	{
+		case LOG_LEVEL_ERROR:
+			return err;
+
+		case LOG_LEVEL_WARNING:
+			return warn;
+
+		case LOG_LEVEL_INFO:
+			return inf;
+
+		case LOG_LEVEL_TRACE:
+			return trace;
+
+		default:
+			return verb;
+	}
+}
@@ -27,8 +27,11 @@
 #define ARDUINOLOGGER_H
 
 #include <Arduino.h>
-#include <TimeLib.h>
 #include <AL_ostream.h>
+#include <AL_clock.h>
+#include <AL_recorder.h>
+#include <AL_isr.h>
+#include <AL_profile.h>
 
 #define LOG_LEVEL_SILENT  0
 #define LOG_LEVEL_ERROR   1
@@ -37,20 +40,90 @@
 #define LOG_LEVEL_TRACE   4
 #define LOG_LEVEL_VERBOSE 5
 
+// Maximum number of outputs of a domain
+#ifndef AL_MAX_OUTPUTS
+# if defined(__AVR__)
+#  define AL_MAX_OUTPUTS 4
+# else
+#  define AL_MAX_OUTPUTS 8
+# endif
+#endif
+
+// Size of the compiled prefix layout of an output
+#ifndef AL_PREFIX_CODE_SIZE
+# if defined(__AVR__)
+#  define AL_PREFIX_CODE_SIZE 16
+# else
+#  define AL_PREFIX_CODE_SIZE 32
+# endif
+#endif
+
+// Maximum length of a prefix, the layout is cut to fit
+#ifndef AL_PREFIX_BUFFER_SIZE
+# define AL_PREFIX_BUFFER_SIZE 64
+#endif
+
+#define LOG_TIME_DATE   0 // 01/01/1970 00:00:00::000
+#define LOG_TIME_MILLIS 1 // millis() counter
+#define LOG_TIME_MICROS 2 // micros() counter
+#define LOG_TIME_DELTA  3 // +1234, microseconds since the previous line of the output
+#define LOG_TIME_EPOCH  4 // 1589203921.123, Unix time in seconds and milliseconds
+
+// Maximum number of characters written to an output at once by logger.service ()
+#ifndef AL_SERVICE_CHUNK
+# define AL_SERVICE_CHUNK 64
+#endif
+
+// Output notified of the beginning and the end of each line it receives
+class LogSink : public Print
+{
+public:
+	virtual void beginLine (uint8_t level){ (void) level; } // Before the first character of a line
+	virtual void endLine (){ }                              // After the end of line characters
+
+	// Deferred output, written by logger.service ()
+	virtual size_t pending () const { return 0; }                  // Number of characters waiting
+	virtual size_t drain (size_t max){ (void) max; return 0; } // Writes up to max waiting characters
+};
+
 typedef struct LogOutput
 {
 	Print * stream;
+	LogSink * sink; // Same as stream for a LogSink output, NULL otherwise
 	uint8_t level;
 	uint8_t displayIndex;
+	uint8_t timeMode;
+	uint32_t lastLineTime;
+	uint8_t prefixCode[AL_PREFIX_CODE_SIZE]; // Compiled prefix layout
+	bool    customPrefix;                    // Layout set by setPrefix (), otherwise built from the flags
+	bool    prefixIndexed;                   // The layout displays the output index
+	bool    colorEnabled;                    // The level name is colored with ANSI escape codes
 	bool    prefixOnNextPrint;
 	bool    prefixEnabled;
 	bool    dateEnabled;
 	bool    levelNameEnabled;
 	bool    disabled;
 	bool    tempDisabled;
+	bool    lineStarted;
+	uint16_t drainCost; // Measured time to drain a character, in 1/16 us, 0 until measured
 	inline bool enabled (){ return !disabled && !tempDisabled; }
 } LogOutput;
 
+// Outputs and state shared by the loggers of a domain
+struct LogRegistry
+{
+	LogOutput * outputs; // Ouputs array
+	uint8_t maxOutputs;  // Outputs array size
+	uint8_t nOutputs;    // Outputs counter
+	uint8_t nDisplayed;  // Enabled outputs counter
+
+	FlightRecorder * flightRecorder; // Recorder of the less important lines
+	LogOutput recorderOutput;        // Recorder output properties, its level is the lowest recorded level
+	uint8_t recordTrigger;           // Level of the lines triggering the recorder dump
+
+	uint8_t serviceNext; // Output drained first by the next service ()
+};
+
 // Do not display prefix for the current line and specified output
 struct npo
 {
@@ -72,13 +145,21 @@ class ArduinoLogger : public ostream
 public:
 	ArduinoLogger();
 	ArduinoLogger(uint8_t levelToOutput);
+	ArduinoLogger(LogRegistry & registry);
+	ArduinoLogger(uint8_t levelToOutput, LogRegistry & registry);
 
-	// Add an output
+	// Add an output (Ignored if AL_MAX_OUTPUTS outputs are already added)
 	void add (Print & stream, uint8_t level,
 	  bool prefixEnabled    = true,
 	  bool dateEnabled      = true,
 	  bool levelNameEnabled = true) const;
 
+	// Add an output that is notified of the beginning and the end of each line
+	void add (LogSink & sink, uint8_t level,
+	  bool prefixEnabled    = true,
+	  bool dateEnabled      = true,
+	  bool levelNameEnabled = true) const;
+
 	// Modify the properties of an output
 	void edit (Print & stream, uint8_t level,
 	  bool prefixEnabled    = true,
@@ -89,10 +170,46 @@ public:
 	void enablePrefix (Print & stream) const;     // Enable prefix
 	void enableDate (Print & stream) const;       // Enable date in prefix
 	void enableLevelName (Print & stream) const;  // Enable level name in prefix
+	void enableColor (Print & stream) const;      // Color the level name with ANSI escape codes
 	void disable (Print & stream) const;          // Disable an output
 	void disablePrefix (Print & stream) const;    // Disable prefix
 	void disableDate (Print & stream) const;      // Disable date in prefix
 	void disableLevelName (Print & stream) const; // Disable level name in prefix
+	void disableColor (Print & stream) const;     // Plain level name
+
+	// Set the prefix layout of an output, NULL restores the default layout "[%T] %I[%L] "
+	// %T clock, %L level name, %O output index ("1|2", nothing with a single output),
+	// %I output index tag ("[1|2] ", nothing with a single output), %% percent sign
+	// The layout is compiled once, the date and level name flags do not apply to it
+	void setPrefix (Print & stream, const char * pattern) const;
+
+	// Select the clock format displayed in the prefix (LOG_TIME_*)
+	void setTimeMode (Print & stream, uint8_t timeMode) const;
+
+	// Select the source of the time displayed in the prefix
+	void setClock (LogClock & clock) const;
+
+	// Record the lines of the specified level and above in the recorder instead of the outputs,
+	// the recorded lines are written to the outputs before the next line of the trigger level or below
+	void record (FlightRecorder & recorder, uint8_t level = LOG_LEVEL_TRACE, uint8_t trigger = LOG_LEVEL_ERROR) const;
+	void stopRecording () const;
+
+	// Output the lines queued by isrLog (), returns the number of lines output
+	uint8_t poll () const;
+
+	// Write the deferred output of the outputs in turn for up to budgetMicros microseconds,
+	// returns the number of characters still waiting
+	// A write is only started if the measured speed of the output predicts it ends within the budget,
+	// an output of unknown speed gets a 1-character write to measure it
+	// The speed estimate of an output skipped for being too slow is halved each time, so it is retried
+	size_t service (uint32_t budgetMicros) const;
+
+	// Output the statistics of the count costliest LOG_SITE statements (compiled with AL_PROFILE)
+	void dumpProfile (uint8_t count = 8) const;
+	void clearProfile () const;
+
+	// Is any output receiving the lines of this instance ?
+	bool isActive () const;
 
 	// Is the output enabled for the specified log level ?
 	bool isEnabled (Print & stream, int level = LOG_LEVEL_SILENT) const;
@@ -104,42 +221,78 @@ public:
 	friend ArduinoLogger & dendl (ArduinoLogger & logger); // Double end of line
 	friend ArduinoLogger & np (ArduinoLogger & logger);    // Do not display prefix for the current line
 	friend ArduinoLogger & cr (ArduinoLogger & logger);    // Carriage return
+	friend ArduinoLogger & eor (ArduinoLogger & logger);   // End of a record, without end of line character
+
+protected:
+	uint8_t getClock (LogOutput * output);
+	uint8_t renderPrefix (LogOutput * output, char * buffer); // Writes up to AL_PREFIX_BUFFER_SIZE characters
+	static void compilePrefix (LogOutput * output, const char * pattern);
+	const char * debugLevelName (uint8_t debugLevel);
+
+	const uint8_t _levelToOutput; // The level that needs to be output by the instance
+
+	static char clock[24]; // 00/00/1970 00:00:00::000
 
 private:
 	void putch (char c);
-	void putstr (const char * str);
+	void putstr (const char * str, size_t len);
 	bool seekoff (off_type off, seekdir way);
 	bool seekpos (pos_type pos);
 	bool sync ();
 	pos_type tellpos ();
 	void setflags ();
 
-	char * getClock ();
 	LogOutput * getLogOutputFromStream (Print & stream) const;
 	void initLogOutput (LogOutput * output, Print & stream, uint8_t level,
 	  bool prefixEnabled,
 	  bool dateEnabled,
 	  bool levelNameEnabled) const;
 
-	const char * debugLevelName (uint8_t debugLevel);
-	void printPrefix (uint8_t index);
+	void printPrefix (LogOutput * output);
+	void printSharedPrefix (uint8_t index);
+	bool samePrefix (const LogOutput * a, const LogOutput * b) const;
+	void beginLine (LogOutput * output);
+	void updatePrefix (LogOutput * output) const;
+	void dumpRecorder ();
 	void setPrefixOnNextPrint (bool prefixOnNextPrint) const;
+	void endLine () const;
 	void updateNDisplayed () const;
 	void updateDisplayIndex () const;
 	void resetTempDisabled () const;
 
-	const uint8_t _levelToOutput; // The level that needs to be output by the instance
+	LogRegistry * const _registry; // Outputs of the domain of the instance
+
+	static LogClock * _clock; // Source of the prefix time
+};
+
+// Independent set of outputs with its own loggers
+// The outputs of a domain only receive the lines logged by the loggers of this domain
+class LogDomain
+{
+	// Declared first, to be initialized before the loggers
+	LogOutput _outputs[AL_MAX_OUTPUTS];
+	LogRegistry _registry;
 
-	static LogOutput * _outputs; // Ouputs array
-	static uint8_t _nOutputs;    // Outputs counter
-	static uint8_t _nDisplayed;  // Enabled outputs counter
-	static char clock[30];       // 00/00/1970 00:00:00::000
+public:
+	LogDomain();
+
+	ArduinoLogger err;          // Error level logging
+	ArduinoLogger warn;         // Warning level logging
+	ArduinoLogger inf;          // Info level logging
+	ArduinoLogger trace;        // Trace level logging
+	ArduinoLogger verb;         // Verbose level logging
+	const ArduinoLogger logger; // Outputs configuration
+
+private:
+	LogDomain(const LogDomain &);
+	LogDomain & operator = (const LogDomain &);
 };
 
 ArduinoLogger & endl (ArduinoLogger & logger);  // End of line
 ArduinoLogger & dendl (ArduinoLogger & logger); // Double end of line
 ArduinoLogger & np (ArduinoLogger & logger);    // Do not display prefix for the current line
 ArduinoLogger & cr (ArduinoLogger & logger);    // Carriage return
+ArduinoLogger & eor (ArduinoLogger & logger);   // End of a record, without end of line character
 
 extern ArduinoLogger err;   // Error level logging
 extern ArduinoLogger warn;  // Warning level logging
@@ -148,4 +301,6 @@ extern ArduinoLogger trace; // Trace level logging
 extern ArduinoLogger verb;  // Verbose level logging
 extern const ArduinoLogger logger;
 
+ArduinoLogger & levelLogger (uint8_t level); // Global logger of a level, verb for LOG_LEVEL_VERBOSE and any other value
+
 #endif // ifndef LOGGER_H
\ No newline at end of file